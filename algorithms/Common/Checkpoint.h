@@ -0,0 +1,221 @@
+#pragma once
+#include <algorithm>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+// Solver state saved at the end of a generation, so a run killed midway
+// resumes from its last checkpoint and goes on exactly as it would have. A
+// checkpoint is a header naming the solver and the run, followed by raw
+// fields in the order the solver writes them, in host byte order: it is
+// read back by the same build on the same kind of machine.
+//
+// Each checkpoint goes to a temporary file that is then renamed over the
+// previous one, so a run killed while saving leaves the last complete one.
+
+// Set by SIGTERM once catchTermination was called. Solvers check it at the
+// end of every generation, save a checkpoint and stop.
+inline volatile std::sig_atomic_t terminationRequested = 0;
+
+inline void catchTermination()
+{
+	std::signal(SIGTERM, [](int) { terminationRequested = 1; });
+}
+
+struct CheckpointHeader
+{
+	std::string solver;
+	std::uint64_t seed = 0;
+	int geneBytes = 0; // bytes of a job gene and a machine gene, which tell the encoding
+	int numberOfGenes = 0;
+	int populationSize = 0; // individuals, or the reef side
+	int generations = 0;
+	int generation = 0; // the last one completed
+
+	// The first field that differs from the running solver's, or nothing if the checkpoint belongs to it
+	std::string mismatch(const CheckpointHeader& expected) const
+	{
+		if (solver != expected.solver) return "it was written by " + solver;
+		if (seed != expected.seed) return "it was written with seed " + std::to_string(seed);
+		if (geneBytes != expected.geneBytes) return "its gene encoding differs";
+		if (numberOfGenes != expected.numberOfGenes) return "it holds " + std::to_string(numberOfGenes) + " operations";
+		if (populationSize != expected.populationSize) return "its population size is " + std::to_string(populationSize);
+		if (generations != expected.generations) return "it was written for " + std::to_string(generations) + " generations";
+		return "";
+	}
+};
+
+class CheckpointWriter
+{
+public:
+	explicit CheckpointWriter(const std::string& path)
+		: path_(path), out_(path + ".tmp", std::ios::binary | std::ios::trunc) {}
+
+	void writeHeader(const CheckpointHeader& header)
+	{
+		writeArray(magic_, sizeof(magic_));
+		write(version_);
+		writeString(header.solver);
+		write(header.seed);
+		write(header.geneBytes);
+		write(header.numberOfGenes);
+		write(header.populationSize);
+		write(header.generations);
+		write(header.generation);
+	}
+
+	// Plain values, random engines included: their state is all they hold
+	template <typename T>
+	void write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "only plain values are written raw");
+		out_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	void writeArray(const T* values, std::size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "only plain values are written raw");
+		out_.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+	}
+
+	void writeString(const std::string& value)
+	{
+		write(static_cast<std::uint64_t>(value.size()));
+		writeArray(value.data(), value.size());
+	}
+
+	// Genes and objectives; any other state of the chromosome type is left to the solver
+	template <typename Chromosome>
+	void writeChromosome(const Chromosome& chromosome)
+	{
+		writeArray(chromosome.processes_, chromosome.numberOfGenes_);
+		writeArray(chromosome.machines_, chromosome.numberOfGenes_);
+		write(chromosome.maxCompletionTime_);
+		write(chromosome.totalEquipmentLoad_);
+		write(chromosome.fitnessValid_);
+	}
+
+	// Replaces the previous checkpoint; false if the file could not be written
+	bool commit()
+	{
+		out_.close();
+		if (out_.fail())
+		{
+			std::remove((path_ + ".tmp").c_str());
+			return false;
+		}
+		return std::rename((path_ + ".tmp").c_str(), path_.c_str()) == 0;
+	}
+
+private:
+	friend class CheckpointReader;
+	static constexpr char magic_[8] = {'J', 'S', 'S', 'P', 'C', 'K', 'P', 'T'};
+	static constexpr std::uint32_t version_ = 2;
+
+	std::string path_;
+	std::ofstream out_;
+};
+
+// Reads fields back in the order they were written. A read past the end or
+// a malformed header fails the reader; callers check good() once at the end.
+class CheckpointReader
+{
+public:
+	explicit CheckpointReader(const std::string& path) : in_(path, std::ios::binary) {}
+
+	bool readHeader(CheckpointHeader& header)
+	{
+		char magic[sizeof(CheckpointWriter::magic_)] = {};
+		std::uint32_t version = 0;
+		readArray(magic, sizeof(magic));
+		read(version);
+		if (!std::equal(magic, magic + sizeof(magic), CheckpointWriter::magic_) || version != CheckpointWriter::version_)
+		{
+			in_.setstate(std::ios::failbit);
+			return false;
+		}
+
+		readString(header.solver);
+		read(header.seed);
+		read(header.geneBytes);
+		read(header.numberOfGenes);
+		read(header.populationSize);
+		read(header.generations);
+		read(header.generation);
+		return good();
+	}
+
+	template <typename T>
+	void read(T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "only plain values are read raw");
+		in_.read(reinterpret_cast<char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	void readArray(T* values, std::size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "only plain values are read raw");
+		in_.read(reinterpret_cast<char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+	}
+
+	void readString(std::string& value)
+	{
+		std::uint64_t size = 0;
+		read(size);
+		if (!good() || size > maxStringSize_)
+		{
+			in_.setstate(std::ios::failbit);
+			return;
+		}
+		value.resize(size);
+		readArray(&value[0], value.size());
+	}
+
+	template <typename Chromosome>
+	void readChromosome(Chromosome& chromosome)
+	{
+		readArray(chromosome.processes_, chromosome.numberOfGenes_);
+		readArray(chromosome.machines_, chromosome.numberOfGenes_);
+		read(chromosome.maxCompletionTime_);
+		read(chromosome.totalEquipmentLoad_);
+		read(chromosome.fitnessValid_);
+	}
+
+	// Counts of stored items, rejected beyond limit so a damaged file cannot size an allocation
+	bool readCount(int& count, int limit)
+	{
+		read(count);
+		if (!good() || count < 0 || count > limit)
+		{
+			in_.setstate(std::ios::failbit);
+			count = 0;
+			return false;
+		}
+		return true;
+	}
+
+	bool good() const { return in_.good(); }
+
+private:
+	static constexpr std::uint64_t maxStringSize_ = std::uint64_t(1) << 30;
+
+	std::ifstream in_;
+};
+
+// The seed a checkpoint was written with, so a resumed run regenerates the same jobs
+inline bool readCheckpointSeed(const std::string& path, std::uint64_t& seed)
+{
+	CheckpointReader in(path);
+	CheckpointHeader header;
+	if (!in.readHeader(header))
+	{
+		return false;
+	}
+	seed = header.seed;
+	return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+
+// Chromosomes addressed by index, with the genes of all of them in one
+// row-major matrix. Chromosome is a plain struct exposing its Genes encoding
+// and processes_, machines_ and numberOfGenes_, which the pool binds to its
+// rows. Storage is kept when the pool is cleared and only grows.
+template <typename Chromosome>
+class ChromosomePool
+{
+public:
+	explicit ChromosomePool(int numberOfGenes = 0) : numberOfGenes_(numberOfGenes) {}
+
+	int size() const { return size_; }
+	// Slots past the previous size keep stale contents until assigned
+	void resize(int size);
+	void clear() { size_ = 0; }
+
+	Chromosome& operator[](int index) { return chromosomes_[index]; }
+	const Chromosome& operator[](int index) const { return chromosomes_[index]; }
+
+private:
+	void bindRows();
+
+	int numberOfGenes_;
+	int size_ = 0;
+	std::vector<typename Chromosome::Genes::JobGene> processes_;
+	std::vector<typename Chromosome::Genes::MachineGene> machines_;
+	std::vector<Chromosome> chromosomes_;
+};
+
+template <typename Chromosome>
+void ChromosomePool<Chromosome>::resize(int size)
+{
+	const int capacity = static_cast<int>(chromosomes_.size());
+	if (size > capacity)
+	{
+		const int newCapacity = std::max(size, 2 * capacity);
+		processes_.resize(static_cast<std::size_t>(newCapacity) * numberOfGenes_);
+		machines_.resize(static_cast<std::size_t>(newCapacity) * numberOfGenes_);
+		chromosomes_.resize(newCapacity);
+		bindRows();
+	}
+	size_ = size;
+}
+
+template <typename Chromosome>
+void ChromosomePool<Chromosome>::bindRows()
+{
+	for (std::size_t i = 0; i < chromosomes_.size(); i++)
+	{
+		chromosomes_[i].processes_ = processes_.data() + i * numberOfGenes_;
+		chromosomes_[i].machines_ = machines_.data() + i * numberOfGenes_;
+		chromosomes_[i].numberOfGenes_ = numberOfGenes_;
+	}
+}
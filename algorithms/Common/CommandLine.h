@@ -0,0 +1,53 @@
+#pragma once
+#include <map>
+#include <string>
+
+// Optional "--name value" flags that follow the positional arguments
+class CommandLine
+{
+public:
+	CommandLine(int argc, char* argv[], int firstOption)
+	{
+		for (int i = firstOption; i < argc; i++)
+		{
+			std::string argument(argv[i]);
+			if (argument.rfind("--", 0) != 0)
+			{
+				continue;
+			}
+
+			std::string name = argument.substr(2);
+			if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0)
+			{
+				options_[name] = argv[++i];
+			}
+			else
+			{
+				options_[name] = "";
+			}
+		}
+	}
+
+	bool has(const std::string& name) const { return options_.count(name) > 0; }
+
+	std::string getString(const std::string& name, const std::string& defaultValue) const
+	{
+		auto option = options_.find(name);
+		return (option == options_.end() || option->second.empty()) ? defaultValue : option->second;
+	}
+
+	int getInt(const std::string& name, int defaultValue) const
+	{
+		auto option = options_.find(name);
+		return (option == options_.end() || option->second.empty()) ? defaultValue : std::stoi(option->second);
+	}
+
+	double getDouble(const std::string& name, double defaultValue) const
+	{
+		auto option = options_.find(name);
+		return (option == options_.end() || option->second.empty()) ? defaultValue : std::stod(option->second);
+	}
+
+private:
+	std::map<std::string, std::string> options_;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Hypervolume of a solver's archive after every generation, written to the
+// given stream as it comes, and the generations and run times at which it
+// improved, so a run shows where it stopped paying off.
+class ConvergenceLog
+{
+public:
+	ConvergenceLog(std::string solverName, std::ostream& out)
+		: solverName_(std::move(solverName)), out_(out), start_(std::chrono::steady_clock::now()) {}
+
+	void record(int generation, long long hypervolume, int frontSize)
+	{
+		const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+		out_ << solverName_ << " generation " << generation << ": hypervolume " << hypervolume << ", " << frontSize << " archived" << std::endl;
+
+		if (improvements_.empty() || hypervolume > improvements_.back().hypervolume)
+		{
+			improvements_.push_back({generation, milliseconds, hypervolume});
+		}
+	}
+
+	void printImprovements() const
+	{
+		out_ << solverName_ << " improvements (generation, ms, hypervolume):";
+		for (const Improvement& improvement : improvements_)
+		{
+			out_ << " " << improvement.generation << "," << static_cast<long long>(improvement.milliseconds) << "," << improvement.hypervolume;
+		}
+		out_ << std::endl;
+	}
+
+private:
+	struct Improvement
+	{
+		int generation;
+		double milliseconds;
+		long long hypervolume;
+	};
+
+	std::string solverName_;
+	std::ostream& out_;
+	std::chrono::steady_clock::time_point start_;
+	std::vector<Improvement> improvements_;
+};
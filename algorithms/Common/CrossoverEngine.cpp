@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include "CrossoverEngine.h"
+
+CrossoverEngine::CrossoverEngine() {}
+
+CrossoverEngine::CrossoverEngine(const ProblemInstance& instance)
+	: instance_(&instance),
+	  firstGroupBits_((instance.numberOfJobs() >> 6) + 1, 0),
+	  jobOrder_(instance.numberOfJobs()),
+	  nextOperation_(instance.numberOfJobs()),
+	  operationPosition_(instance.numberOfOperations())
+{
+}
+
+void CrossoverEngine::splitJobs(RandomEngine& gen)
+{
+	std::iota(jobOrder_.begin(), jobOrder_.end(), 1);
+
+	// Ensure that each group has at least a third of the jobs
+	const int numberOfJobs = static_cast<int>(jobOrder_.size());
+	const int minGroupSize = numberOfJobs / 3;
+
+	std::uniform_int_distribution<> distribution(minGroupSize, numberOfJobs - minGroupSize);
+	const int firstGroupSize = distribution(gen);
+
+	// The first group is a random subset of firstGroupSize jobs
+	std::shuffle(jobOrder_.begin(), jobOrder_.end(), gen);
+
+	std::fill(firstGroupBits_.begin(), firstGroupBits_.end(), 0);
+	for (int i = 0; i < firstGroupSize; i++)
+	{
+		const int jobId = jobOrder_[i];
+		firstGroupBits_[jobId >> 6] |= std::uint64_t(1) << (jobId & 63);
+	}
+}
+
+template <typename JobGene, typename MachineGene>
+void CrossoverEngine::jobBasedCrossover(const JobGene* keptProcesses, const MachineGene* keptMachines,
+										const JobGene* otherProcesses, const MachineGene* otherMachines,
+										bool keepFirstGroup, JobGene* childProcesses, MachineGene* childMachines) const
+{
+	const int numberOfGenes = instance_->numberOfOperations();
+
+	// Both parents hold the same operations, so the kept parent has exactly as many
+	// free positions as the other parent has genes of the other group
+	int other = 0;
+	for (int gene = 0; gene < numberOfGenes; gene++)
+	{
+		if (inFirstGroup(keptProcesses[gene]) == keepFirstGroup)
+		{
+			childProcesses[gene] = keptProcesses[gene];
+			childMachines[gene] = keptMachines[gene];
+			continue;
+		}
+
+		while (inFirstGroup(otherProcesses[other]) == keepFirstGroup)
+		{
+			other++;
+		}
+		childProcesses[gene] = otherProcesses[other];
+		childMachines[gene] = otherMachines[other];
+		other++;
+	}
+}
+
+template <typename JobGene, typename MachineGene>
+void CrossoverEngine::machineBasedCrossover(const JobGene* processes1, MachineGene* machines1,
+											const JobGene* processes2, MachineGene* machines2,
+											const std::vector<int>& machineMask)
+{
+	const int numberOfGenes = instance_->numberOfOperations();
+
+	// The k-th gene of a job is the job's k-th operation
+	resetOperations();
+	for (int gene = 0; gene < numberOfGenes; gene++)
+	{
+		operationPosition_[nextOperation_[processes2[gene] - 1]++] = gene;
+	}
+
+	resetOperations();
+	for (int gene = 0; gene < numberOfGenes; gene++)
+	{
+		const int operation = nextOperation_[processes1[gene] - 1]++;
+		if (machineMask[gene] == 1)
+		{
+			std::swap(machines1[gene], machines2[operationPosition_[operation]]);
+		}
+	}
+}
+
+void CrossoverEngine::resetOperations()
+{
+	for (int jobIndex = 0; jobIndex < static_cast<int>(nextOperation_.size()); jobIndex++)
+	{
+		nextOperation_[jobIndex] = instance_->jobOffset(jobIndex);
+	}
+}
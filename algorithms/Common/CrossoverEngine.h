@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "ProblemInstance.h"
+#include "RandomEngine.h"
+
+// Crossover operators shared by both solvers. A child is written in one pass
+// over the genes: job groups are a membership bitset and matching operations
+// are found through an operation -> position index of the other parent, so
+// nothing is searched for. Scratch buffers are sized once for the instance;
+// an engine is not thread-safe, use one per thread.
+class CrossoverEngine
+{
+public:
+	CrossoverEngine();
+	explicit CrossoverEngine(const ProblemInstance& instance);
+
+	// Randomly splits the job ids into two groups, each with at least a third of the jobs
+	void splitJobs(RandomEngine& gen);
+	bool inFirstGroup(int jobId) const { return (firstGroupBits_[jobId >> 6] >> (jobId & 63)) & 1; }
+
+	// Job-based crossover of the last split. Genes of the kept parent whose job is in
+	// the kept group stay in place; the other positions take, in order, the genes of
+	// the other parent whose job is in the other group.
+	template <typename JobGene, typename MachineGene>
+	void jobBasedCrossover(const JobGene* keptProcesses, const MachineGene* keptMachines,
+						   const JobGene* otherProcesses, const MachineGene* otherMachines,
+						   bool keepFirstGroup, JobGene* childProcesses, MachineGene* childMachines) const;
+
+	// Machine-based crossover. For every gene of the first chromosome selected by
+	// machineMask, swaps its machine with the one the second chromosome assigns to
+	// the same operation.
+	template <typename JobGene, typename MachineGene>
+	void machineBasedCrossover(const JobGene* processes1, MachineGene* machines1,
+							   const JobGene* processes2, MachineGene* machines2,
+							   const std::vector<int>& machineMask);
+
+private:
+	// Resets the per-job operation cursors to the first operation of each job
+	void resetOperations();
+
+	const ProblemInstance* instance_ = nullptr;
+
+	std::vector<std::uint64_t> firstGroupBits_;	// bit jobId
+	std::vector<int> jobOrder_;					// job ids, shuffled by splitJobs
+	std::vector<int> nextOperation_;			// <jobIndex, operation id of the job's next gene>
+	std::vector<int> operationPosition_;		// <operation id, gene position in the second chromosome>
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+
+// Prefix counts over dense ranks [0, size)
+class FenwickTree
+{
+public:
+	void reset(int size)
+	{
+		tree_.assign(size + 1, 0);
+	}
+
+	void add(int rank, int value)
+	{
+		for (int i = rank + 1; i < static_cast<int>(tree_.size()); i += i & -i)
+		{
+			tree_[i] += value;
+		}
+	}
+
+	// Sum of the values added at ranks [0, rank]
+	int prefixSum(int rank) const
+	{
+		int sum = 0;
+		for (int i = rank + 1; i > 0; i -= i & -i)
+		{
+			sum += tree_[i];
+		}
+		return sum;
+	}
+
+private:
+	std::vector<int> tree_;
+};
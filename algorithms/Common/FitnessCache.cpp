@@ -0,0 +1,78 @@
+#pragma once
+
+#include <iomanip>
+
+#include "FitnessCache.h"
+
+FitnessCache::FitnessCache(std::size_t capacity)
+{
+	// Round up to a power of two so the slot is a mask of the key
+	std::size_t slots = 1;
+	while (slots < capacity)
+	{
+		slots <<= 1;
+	}
+
+	slots_.reset(new Slot[slots]);
+	mask_ = slots - 1;
+}
+
+template <typename Genes>
+std::uint64_t FitnessCache::hash(const ChromosomeRef<Genes>& chromosome, int length)
+{
+	std::uint64_t hash = 0x9E3779B97F4A7C15ULL ^ static_cast<std::uint64_t>(length);
+	for (int gene = 0; gene < length; gene++)
+	{
+		const std::uint64_t word = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chromosome.processes[gene])) << 32) |
+								   static_cast<std::uint32_t>(chromosome.machines[gene]);
+		hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+		hash ^= hash >> 31;
+	}
+
+	// splitmix64 finalizer
+	hash ^= hash >> 30;
+	hash *= 0xBF58476D1CE4E5B9ULL;
+	hash ^= hash >> 27;
+	hash *= 0x94D049BB133111EBULL;
+	hash ^= hash >> 31;
+
+	// 0 marks an empty slot
+	return hash == 0 ? 1 : hash;
+}
+
+bool FitnessCache::find(std::uint64_t key, Fitness& fitness)
+{
+	Slot& slot = slots_[key & mask_];
+	const std::uint64_t value = slot.value.load(std::memory_order_acquire);
+	const std::uint64_t check = slot.check.load(std::memory_order_acquire);
+
+	if ((check ^ value) != key)
+	{
+		misses_.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	fitness.maxCompletionTime = static_cast<int>(value >> 32);
+	fitness.totalEquipmentLoad = static_cast<int>(value & 0xFFFFFFFFULL);
+	hits_.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void FitnessCache::insert(std::uint64_t key, const Fitness& fitness)
+{
+	const std::uint64_t value = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(fitness.maxCompletionTime)) << 32) |
+								static_cast<std::uint32_t>(fitness.totalEquipmentLoad);
+
+	Slot& slot = slots_[key & mask_];
+	slot.check.store(key ^ value, std::memory_order_release);
+	slot.value.store(value, std::memory_order_release);
+}
+
+void FitnessCache::printStatistics(std::ostream& os, const std::string& label) const
+{
+	const std::uint64_t lookups = hits() + misses();
+	const double hitRate = lookups == 0 ? 0.0 : 100.0 * static_cast<double>(hits()) / static_cast<double>(lookups);
+
+	os << label << " fitness cache: " << hits() << " hits, " << misses() << " misses ("
+	   << std::fixed << std::setprecision(1) << hitRate << "% hit rate, " << (mask_ + 1) << " slots)" << std::endl;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "ScheduleDecoder.h"
+
+// Bounded, lock-free memo of chromosome objectives shared by all threads.
+// Slots are direct-mapped by a 64-bit chromosome hash and always replaced on
+// insert. Each slot stores (key ^ value, value), so a lookup that races a
+// writer sees a mismatching key and simply misses.
+class FitnessCache
+{
+public:
+	explicit FitnessCache(std::size_t capacity);
+
+	// Depends only on the gene values, not on the encoding that stores them
+	template <typename Genes>
+	static std::uint64_t hash(const ChromosomeRef<Genes>& chromosome, int length);
+
+	bool find(std::uint64_t key, Fitness& fitness);
+	void insert(std::uint64_t key, const Fitness& fitness);
+
+	std::uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+	std::uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+	void printStatistics(std::ostream& os, const std::string& label) const;
+
+private:
+	struct Slot
+	{
+		std::atomic<std::uint64_t> check{0};
+		std::atomic<std::uint64_t> value{0};
+	};
+
+	std::unique_ptr<Slot[]> slots_;
+	std::size_t mask_ = 0;
+
+	alignas(64) std::atomic<std::uint64_t> hits_{0};
+	alignas(64) std::atomic<std::uint64_t> misses_{0};
+};
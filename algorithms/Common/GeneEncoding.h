@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+#include "ProblemInstance.h"
+
+// Integer types of the two gene strings of a chromosome: 1-based job ids and
+// 1-based machine ids.
+template <typename JobId, typename MachineId>
+struct GeneEncoding
+{
+	using JobGene = JobId;
+	using MachineGene = MachineId;
+
+	static bool fits(const ProblemInstance& instance)
+	{
+		return instance.numberOfJobs() <= static_cast<long long>(std::numeric_limits<JobId>::max()) &&
+			   instance.numberOfMachines() <= static_cast<long long>(std::numeric_limits<MachineId>::max());
+	}
+};
+
+// Three bytes per gene, up to 65535 jobs on 255 machines
+using CompactGenes = GeneEncoding<std::uint16_t, std::uint8_t>;
+// Any instance
+using WideGenes = GeneEncoding<int, int>;
+
+// Calls visitor(Genes()) with the narrowest encoding that holds the instance.
+// Solvers are templates on the encoding and are instantiated for each of them.
+template <typename Visitor>
+void withGeneEncoding(const ProblemInstance& instance, bool allowCompact, Visitor&& visitor)
+{
+	if (allowCompact && CompactGenes::fits(instance))
+	{
+		visitor(CompactGenes());
+	}
+	else
+	{
+		visitor(WideGenes());
+	}
+}
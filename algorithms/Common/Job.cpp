@@ -1,3 +1,5 @@
+#pragma once
+
 #include "Job.h"
 
 Job::Job() {}
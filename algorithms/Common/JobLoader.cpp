@@ -0,0 +1,238 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <random>
+#include <map>
+
+#include "JobLoader.h"
+#include "RandomEngine.h"
+#include "Job.cpp"
+
+std::vector<Job> loadJobs(const std::string& useDefault, int numberOfJobs, int numberOfMachines, int numberOfProcesses, std::uint64_t seed)
+{
+	if (useDefault.size() == 1) {
+		if (std::stoi(useDefault) == 1) 
+		{
+			return importDefaultSample(numberOfJobs);
+		} 
+		else 
+		{
+			return generateJobs(numberOfJobs, numberOfProcesses, numberOfMachines, seed);
+		}
+	}
+
+	return importDefaultSample(numberOfJobs, useDefault);
+}
+
+std::vector<Job> importDefaultSample(int numberOfJobs, std::string fileName)
+{
+	std::vector<Job> jobs = std::vector<Job>(numberOfJobs);
+
+	std::ifstream file(fileName);
+	std::string content;
+
+	if (!file.is_open()) 
+	{
+        content = "1,1:12,5,18,10,16,23,18,12,21,13;1,2:15,12,5,16,7,18,21,17,16,9;1,3:17,4,12,11,9,14,11,10,25,10;2,1:19,14,5,17,16,13,10,15,14,6;2,2:18,14,24,11,16,19,20,9,22,7;2,3:13,16,10,15,18,16,17,5,15,16;2,4:8,7,12,6,5,10,22,8,8,17;3,1:16,13,18,6,14,7,20,12,19,5;3,2:11,10,9,16,11,8,5,12,10,5;4,1:21,17,21,16,20,5,18,8,19,17;4,2:5,24,12,20,17,18,20,22,21,14;4,3:6,7,5,5,7,6,16,9,17,10;5,1:23,14,12,5,15,11,13,14,5,16;5,2:15,5,22,12,16,8,13,18,8,13;5,3:12,10,11,14,15,25,16,13,15,15;6,1:5,15,6,17,20,16,14,10,5,19;6,2:14,13,12,5,15,7,11,14,17,13;7,1:18,21,15,12,9,24,7,5,20,7;7,2:17,14,15,17,19,20,15,12,16,15;7,3:8,10,9,8,7,12,14,7,8,9;7,4:15,20,18,23,5,16,10,16,6,21;7,5:12,25,16,8,15,9,18,17,20,5;7,6:10,8,7,7,7,8,9,17,6,8;8,1:17,20,8,23,19,19,11,15,16,5;8,2:5,18,15,20,16,22,19,17,13,14;8,3:24,7,26,24,25,24,9,18,10,20;8,4:5,22,16,18,13,7,19,8,20,21;9,1:5,7,7,11,8,11,10,23,8,18;9,2:24,25,7,22,12,18,5,20,17,21;9,3:15,9,13,13,14,10,12,11,16,10;10,1:20,21,18,11,19,18,17,8,22,19;10,2:15,14,8,15,10,16,13,15,16,12;10,3:11,15,8,12,10,13,23,8,9,9";
+    } 
+	else 
+	{
+		if (fileName.compare("dataset.txt") == 0) 
+		{
+			content = std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		} 
+		else 
+		{
+			std::stringstream result;
+
+			int number_total_jobs, number_total_machines, number_max_operations;
+			std::string line;
+			std::getline(file, line);
+			std::istringstream headerStream(line);
+			headerStream >> number_total_jobs >> number_total_machines >> number_max_operations;
+
+			// Set Job Id to 1 to initiate dataset load
+			int currentJob = 1;
+
+			while (std::getline(file, line)) 
+			{
+				if (currentJob > number_total_jobs) 
+				{
+					break;
+				}
+
+
+				std::istringstream lineStream(line);
+				int number_operations;
+				lineStream >> number_operations;
+
+				for (int id_operation = 0; id_operation < number_operations; ++id_operation) 
+				{
+					result << currentJob << "," << id_operation+1 << ":";
+					int machinesNumber;
+					lineStream >> machinesNumber;
+					std::map<int,int> machinesMap;
+					for (int i = 1; i <= number_total_machines; i++) 
+					{
+						machinesMap.insert(std::make_pair(i,100));
+					}
+					for (int i = 0; i < machinesNumber; i++) 
+					{
+						int machine, time;
+						lineStream >> machine >> time;
+						machinesMap[machine] = time;
+					}
+
+					for (int i = 1; i <= number_total_machines; i++) 
+					{
+						if (i == number_total_machines) 
+						{
+							result << machinesMap[i] << ";";
+							break;
+						}
+						result << machinesMap[i] << ",";
+					}
+				}
+				currentJob++;
+			}
+
+			content = result.str();
+		}
+	}
+
+	size_t firstPeriodPos = content.find('.');
+    std::string jobsStr = content.substr(0, firstPeriodPos);
+    std::istringstream ssJobs(jobsStr);
+    std::string tokenJobs;
+
+	int currentJobIndex = 0;
+    while (std::getline(ssJobs, tokenJobs, ';')) 
+	{
+        size_t colonPos = tokenJobs.find(':');
+        std::string operation = tokenJobs.substr(0, colonPos);
+        std::string durations = tokenJobs.substr(colonPos + 1);
+
+        std::istringstream durationsStream(durations);
+        std::vector<std::string> durationsArray(std::istream_iterator<std::string>{durationsStream}, 
+                                                std::istream_iterator<std::string>());
+
+		size_t colonPos2 = operation.find(',');
+        std::string jobId = operation.substr(0, colonPos2);
+
+		std::stringstream ssDurations(durations);
+		std::string tokenDurations;
+
+		std::map<int, int> processDurations;
+		int machineIndex = 0;
+		while (std::getline(ssDurations, tokenDurations, ',')) 
+		{
+			processDurations[machineIndex] = std::stoi(tokenDurations);
+			machineIndex++;
+		}
+
+		if (std::stoi(jobId) != (currentJobIndex+1)) 
+		{
+			currentJobIndex++;
+			
+		}
+		jobs[currentJobIndex].processes.push_back(Job::Process(processDurations));
+    }
+
+	file.close();
+	return jobs;
+}
+
+std::vector<Job> generateJobs(int numberOfJobs, int numberOfProcesses, int numberOfMachines, std::uint64_t seed)
+{
+	std::vector<Job> jobs;
+
+	RandomEngine gen(seed, JobGenerationStream);
+	std::uniform_int_distribution<> dis(0, numberOfJobs - 1);
+
+	for (int i = 0; i < numberOfJobs; i++) 
+	{
+		std::vector<Job::Process> jobProcesses;
+
+		std::map<int, int> processDurations;
+
+		for (int machineIndex = 0; machineIndex < numberOfMachines; ++machineIndex) {
+			processDurations[machineIndex] = std::max(static_cast<int>(gen() % maxGeneratedDuration) + 1, 1); // Random duration for each machine
+		}
+		jobProcesses.push_back(Job::Process(processDurations));
+		jobs.push_back(Job(jobProcesses));
+
+		numberOfProcesses--;
+	}
+
+	while (numberOfProcesses > 0) 
+	{
+		int randomJob = dis(gen);
+
+		std::map<int, int> processDurations;
+
+		for (int machineIndex = 0; machineIndex < numberOfMachines; ++machineIndex) 
+		{
+			processDurations[machineIndex] = std::max(static_cast<int>(gen() % maxGeneratedDuration) + 1, 1); // Random duration for each machine
+		}
+
+		jobs[randomJob].processes.push_back(Job::Process(processDurations));
+
+		numberOfProcesses--;
+	}
+
+	return jobs;
+}
+
+void printJobs(const std::vector<Job>& jobs)
+{
+	for (int i = 0; i < jobs.size(); ++i) 
+	{
+		std::cout << "Job " << i + 1 << ":\n";
+		for (int j = 0; j < jobs[i].processes.size(); ++j) 
+		{
+			std::cout << "  Process " << j + 1 << ":\n";
+			for (const auto& durationPair : jobs[i].processes[j].machineDurations) 
+			{
+				std::cout << "    Machine " << durationPair.first << ": " << durationPair.second << " minutes\n";
+			}
+		}
+		std::cout << std::endl;
+	}
+}
+
+void outputJobs(const std::vector<Job>& jobs)
+{
+	for (int i = 0; i < jobs.size(); ++i) 
+	{
+		for (int j = 0; j < jobs[i].processes.size(); ++j) 
+		{
+			std::cout << i + 1 << "," << j + 1 << ":";
+			for (const auto& durationPair : jobs[i].processes[j].machineDurations) 
+			{
+				if (std::addressof(durationPair) == std::addressof(*(std::prev(jobs[i].processes[j].machineDurations.end())))) 
+				{
+					if (i + 1 != jobs.size()) 
+					{
+						std::cout << durationPair.second << ";";
+					}
+					else 
+					{
+						if (j + 1 == jobs[i].processes.size())
+							std::cout << durationPair.second << ".";
+						else 
+						{
+							std::cout << durationPair.second << ";";
+						}
+					}
+				}
+				else 
+				{
+					std::cout << durationPair.second << ",";
+				}
+			}
+		}
+	}
+}
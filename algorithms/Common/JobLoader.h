@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Job.h"
+
+// Upper bound of the machine durations of generated jobs
+const int maxGeneratedDuration = 10;
+
+// Jobs of a run. useDefault "1" imports dataset.txt (or the built-in sample
+// when it is missing), any other single character generates random jobs and
+// anything longer is the name of an .fjs file. Generated jobs are drawn from
+// the JobGenerationStream of seed.
+std::vector<Job> loadJobs(const std::string& useDefault, int numberOfJobs, int numberOfMachines, int numberOfProcesses, std::uint64_t seed);
+
+std::vector<Job> importDefaultSample(int numberOfJobs, std::string fileName = "dataset.txt");
+std::vector<Job> generateJobs(int numberOfJobs, int numberOfProcesses, int numberOfMachines, std::uint64_t seed);
+
+// Writes the jobs in the "job,process:durations;...." format the frontend parses
+void outputJobs(const std::vector<Job>& jobs);
+void printJobs(const std::vector<Job>& jobs);
@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+
+#include "ChromosomePool.h"
+
+// One-way channel that carries migrants to an island. Batches are double
+// buffered by migration round: the sender copies its migrants into the buffer
+// of its round and publishes it with a release store, the receiver takes the
+// batch of the previous round with an acquire load. Neither side locks or
+// waits, and a buffer is only refilled two rounds later, after it was read.
+template <typename Chromosome>
+class MigrationMailbox
+{
+public:
+	explicit MigrationMailbox(int numberOfGenes)
+		: batches_{ChromosomePool<Chromosome>(numberOfGenes), ChromosomePool<Chromosome>(numberOfGenes)}
+	{
+		publishedRounds_[0].store(-1, std::memory_order_relaxed);
+		publishedRounds_[1].store(-1, std::memory_order_relaxed);
+	}
+
+	MigrationMailbox(const MigrationMailbox&) = delete;
+	MigrationMailbox& operator=(const MigrationMailbox&) = delete;
+
+	void post(int round, const Chromosome* const* migrants, int count)
+	{
+		ChromosomePool<Chromosome>& batch = batches_[round & 1];
+		batch.resize(count);
+		for (int i = 0; i < count; i++)
+		{
+			batch[i].copyFrom(*migrants[i]);
+		}
+		publishedRounds_[round & 1].store(round, std::memory_order_release);
+	}
+
+	// The batch posted in round, or nullptr if nothing was posted in it yet
+	const ChromosomePool<Chromosome>* collect(int round) const
+	{
+		if (round < 0 || publishedRounds_[round & 1].load(std::memory_order_acquire) != round)
+		{
+			return nullptr;
+		}
+		return &batches_[round & 1];
+	}
+
+private:
+	ChromosomePool<Chromosome> batches_[2];
+	std::atomic<int> publishedRounds_[2];
+};
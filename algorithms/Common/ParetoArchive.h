@@ -0,0 +1,428 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ChromosomePool.h"
+#include "RandomEngine.h"
+#include "Checkpoint.h"
+
+// Genes and objectives of one archived schedule
+template <typename GeneEncodingT>
+struct ArchiveMember
+{
+	using Genes = GeneEncodingT;
+	using JobGene = typename Genes::JobGene;
+	using MachineGene = typename Genes::MachineGene;
+
+	JobGene* processes_ = nullptr;
+	MachineGene* machines_ = nullptr;
+	int numberOfGenes_ = 0;
+	int maxCompletionTime_ = 0;
+	int totalEquipmentLoad_ = 0;
+	bool fitnessValid_ = true;
+};
+
+// Non-dominated makespan / equipment load pairs seen by one or more solvers,
+// with the genes of a schedule for each. Members of any chromosome type with
+// the same Genes encoding can be offered and copied out, so NSGA-II
+// individuals and CRO corals share one archive. All methods lock, the
+// archive may be used from several threads.
+//
+// In two objectives the front is a staircase: by increasing makespan the
+// load strictly decreases. It is kept in a map keyed by makespan, so an
+// offer finds its only possible dominator, the step at or before its
+// makespan, in O(log n), and the steps it dominates follow that position.
+//
+// The hypervolume against a reference point is kept up to date the same
+// way: an offer only changes the areas of the steps it touches. Objectives
+// are integers, so it is exact.
+//
+// With epsilon > 0 objectives are first mapped to a logarithmic grid with
+// boxes (1 + epsilon) wide, and dominance is decided between boxes. Each
+// box holds one member, so the archive keeps an epsilon-approximation of
+// the front whose size is bounded by the objective ranges, not by the run.
+template <typename Genes>
+class ParetoArchive
+{
+public:
+	explicit ParetoArchive(int numberOfGenes, double epsilon = 0.0)
+		: numberOfGenes_(numberOfGenes), slots_(numberOfGenes), epsilon_(epsilon), logBoxWidth_(std::log1p(epsilon)) {}
+
+	ParetoArchive(const ParetoArchive&) = delete;
+	ParetoArchive& operator=(const ParetoArchive&) = delete;
+
+	// Adds an evaluated chromosome unless a member's box dominates its box, and
+	// removes the members whose boxes it dominates. Within one box the member
+	// that dominates the other stays, else the one nearer the box corner; on
+	// equal objectives the smaller genes stay, so the contents do not depend on
+	// offer order.
+	template <typename Chromosome>
+	bool offer(const Chromosome& chromosome);
+
+	// Offers every member to target and returns how many it took. Safe in both
+	// directions between two archives, and with target being this archive.
+	int offerMembers(ParetoArchive& target) const;
+
+	// Appends count members spread along the front (all of them if there are
+	// fewer) to out. The copies carry valid objectives; any other state of the
+	// chromosome type is left to the caller.
+	template <typename Chromosome>
+	void sample(ChromosomePool<Chromosome>& out, int count, RandomEngine& gen) const;
+
+	// Appends every member to out, by increasing makespan
+	template <typename Chromosome>
+	void copyMembers(ChromosomePool<Chromosome>& out) const;
+
+	int size() const;
+
+	long long hypervolume() const;
+	// Fixes the reference point a tenth beyond the worst objectives offered so far
+	void fixReferencePoint();
+	void setReferencePoint(std::pair<int, int> referencePoint);
+	std::pair<int, int> referencePoint() const;
+
+	// The reference point and the members. Restoring offers them again, which
+	// rebuilds the same archive since its contents do not depend on offer order.
+	void save(CheckpointWriter& out) const;
+	bool restore(CheckpointReader& in);
+
+private:
+	// A member of the staircase, keyed by the makespan box in front_
+	struct Step
+	{
+		int loadBox;
+		int slot;
+	};
+
+	using StepIterator = typename std::map<int, Step>::const_iterator;
+
+	// Area dominated by a step alone, up to the next step's makespan
+	long long stepArea(StepIterator step) const;
+	int box(int objective) const;
+	template <typename Chromosome>
+	bool replacesInBox(const Chromosome& chromosome, const ArchiveMember<Genes>& member) const;
+	double cornerDistance(int makespan, int load) const;
+	template <typename Chromosome>
+	static bool hasSmallerGenes(const Chromosome& chromosome, const ArchiveMember<Genes>& member);
+	template <typename Target, typename Source>
+	static void copyChromosome(Target& target, const Source& source);
+	template <typename Chromosome>
+	static void appendCopy(ChromosomePool<Chromosome>& out, const ArchiveMember<Genes>& member);
+
+	mutable std::mutex mutex_;
+	int numberOfGenes_;
+	ChromosomePool<ArchiveMember<Genes>> slots_;
+	std::map<int, Step> front_; // makespan box -> step, load boxes decrease along it
+	std::vector<int> freeSlots_;
+	mutable std::vector<int> sampled_; // slots in front order, for sample
+	double epsilon_;
+	double logBoxWidth_;
+	long long hypervolume_ = 0;
+	int referenceMakespan_ = 0, referenceLoad_ = 0; // nothing counts before it is set
+	int worstMakespan_ = 0, worstLoad_ = 0; // over every offer
+	static constexpr int maxRestoredMembers_ = 1 << 24;
+};
+
+template <typename Genes>
+template <typename Chromosome>
+bool ParetoArchive<Genes>::offer(const Chromosome& chromosome)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	worstMakespan_ = std::max(worstMakespan_, chromosome.maxCompletionTime_);
+	worstLoad_ = std::max(worstLoad_, chromosome.totalEquipmentLoad_);
+
+	const int makespanBox = box(chromosome.maxCompletionTime_);
+	const int loadBox = box(chromosome.totalEquipmentLoad_);
+
+	// The step at or before the makespan box has the lowest load box of all steps that could dominate
+	auto position = front_.upper_bound(makespanBox);
+	if (position != front_.begin())
+	{
+		const auto previous = std::prev(position);
+		const Step& step = previous->second;
+		if (step.loadBox < loadBox || (step.loadBox == loadBox && previous->first < makespanBox))
+		{
+			return false;
+		}
+		if (previous->first == makespanBox)
+		{
+			if (step.loadBox == loadBox && !replacesInBox(chromosome, slots_[step.slot]))
+			{
+				return false;
+			}
+			position = previous;
+		}
+	}
+
+	// The step before keeps its place but ends at the newcomer's makespan
+	const StepIterator before = position == front_.begin() ? front_.cend() : std::prev(StepIterator(position));
+	if (before != front_.cend())
+	{
+		hypervolume_ -= stepArea(before);
+	}
+
+	// The following steps with a load box at least as high are dominated, or share the box
+	while (position != front_.end() && position->second.loadBox >= loadBox)
+	{
+		hypervolume_ -= stepArea(position);
+		freeSlots_.push_back(position->second.slot);
+		position = front_.erase(position);
+	}
+
+	int slot;
+	if (freeSlots_.empty())
+	{
+		slot = slots_.size();
+		slots_.resize(slot + 1);
+	}
+	else
+	{
+		slot = freeSlots_.back();
+		freeSlots_.pop_back();
+	}
+	copyChromosome(slots_[slot], chromosome);
+	hypervolume_ += stepArea(front_.emplace_hint(position, makespanBox, Step{loadBox, slot}));
+	if (before != front_.cend())
+	{
+		hypervolume_ += stepArea(before);
+	}
+	return true;
+}
+
+template <typename Genes>
+int ParetoArchive<Genes>::offerMembers(ParetoArchive& target) const
+{
+	// The members are copied out under this archive's lock and offered after it is
+	// released, so no thread holds two archive locks and any two archives, or one
+	// with itself, can offer to each other
+	ChromosomePool<ArchiveMember<Genes>> members(numberOfGenes_);
+	copyMembers(members);
+
+	int accepted = 0;
+	for (int i = 0; i < members.size(); i++)
+	{
+		accepted += target.offer(members[i]);
+	}
+	return accepted;
+}
+
+template <typename Genes>
+template <typename Chromosome>
+void ParetoArchive<Genes>::sample(ChromosomePool<Chromosome>& out, int count, RandomEngine& gen) const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	const int size = static_cast<int>(front_.size());
+	if (size == 0 || count <= 0)
+	{
+		return;
+	}
+	count = std::min(count, size);
+
+	// Evenly spaced members from a random start
+	const int start = static_cast<int>(gen() % size);
+	sampled_.clear();
+	for (const auto& step : front_)
+	{
+		sampled_.push_back(step.second.slot);
+	}
+	for (int k = 0; k < count; k++)
+	{
+		appendCopy(out, slots_[sampled_[(start + static_cast<long long>(k) * size / count) % size]]);
+	}
+}
+
+template <typename Genes>
+template <typename Chromosome>
+void ParetoArchive<Genes>::copyMembers(ChromosomePool<Chromosome>& out) const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (const auto& step : front_)
+	{
+		appendCopy(out, slots_[step.second.slot]);
+	}
+}
+
+template <typename Genes>
+int ParetoArchive<Genes>::size() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return static_cast<int>(front_.size());
+}
+
+template <typename Genes>
+long long ParetoArchive<Genes>::hypervolume() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return hypervolume_;
+}
+
+template <typename Genes>
+void ParetoArchive<Genes>::fixReferencePoint()
+{
+	int worstMakespan, worstLoad;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		worstMakespan = worstMakespan_;
+		worstLoad = worstLoad_;
+	}
+	setReferencePoint({worstMakespan + worstMakespan / 10 + 1, worstLoad + worstLoad / 10 + 1});
+}
+
+template <typename Genes>
+void ParetoArchive<Genes>::setReferencePoint(std::pair<int, int> referencePoint)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	referenceMakespan_ = referencePoint.first;
+	referenceLoad_ = referencePoint.second;
+
+	hypervolume_ = 0;
+	for (auto step = front_.cbegin(); step != front_.cend(); ++step)
+	{
+		hypervolume_ += stepArea(step);
+	}
+}
+
+template <typename Genes>
+std::pair<int, int> ParetoArchive<Genes>::referencePoint() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return {referenceMakespan_, referenceLoad_};
+}
+
+template <typename Genes>
+void ParetoArchive<Genes>::save(CheckpointWriter& out) const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	out.write(referenceMakespan_);
+	out.write(referenceLoad_);
+	out.write(static_cast<int>(front_.size()));
+	for (const auto& step : front_)
+	{
+		out.writeChromosome(slots_[step.second.slot]);
+	}
+}
+
+template <typename Genes>
+bool ParetoArchive<Genes>::restore(CheckpointReader& in)
+{
+	std::pair<int, int> referencePoint;
+	int size = 0;
+	in.read(referencePoint.first);
+	in.read(referencePoint.second);
+	if (!in.readCount(size, maxRestoredMembers_))
+	{
+		return false;
+	}
+
+	ChromosomePool<ArchiveMember<Genes>> members(numberOfGenes_);
+	members.resize(size);
+	for (int i = 0; i < size; i++)
+	{
+		in.readChromosome(members[i]);
+	}
+	if (!in.good())
+	{
+		return false;
+	}
+
+	for (int i = 0; i < size; i++)
+	{
+		offer(members[i]);
+	}
+	setReferencePoint(referencePoint);
+	return true;
+}
+
+template <typename Genes>
+long long ParetoArchive<Genes>::stepArea(StepIterator step) const
+{
+	const ArchiveMember<Genes>& member = slots_[step->second.slot];
+	const auto next = std::next(step);
+	const int nextMakespan = next == front_.cend() ? referenceMakespan_ : slots_[next->second.slot].maxCompletionTime_;
+
+	const long long width = std::min(nextMakespan, referenceMakespan_) - std::min(member.maxCompletionTime_, referenceMakespan_);
+	const long long height = std::max(0, referenceLoad_ - member.totalEquipmentLoad_);
+	return width * height;
+}
+
+template <typename Genes>
+int ParetoArchive<Genes>::box(int objective) const
+{
+	if (epsilon_ <= 0.0)
+	{
+		return objective;
+	}
+	return static_cast<int>(std::floor(std::log(static_cast<double>(std::max(objective, 1))) / logBoxWidth_));
+}
+
+template <typename Genes>
+template <typename Chromosome>
+bool ParetoArchive<Genes>::replacesInBox(const Chromosome& chromosome, const ArchiveMember<Genes>& member) const
+{
+	const int makespan = chromosome.maxCompletionTime_, load = chromosome.totalEquipmentLoad_;
+	const int memberMakespan = member.maxCompletionTime_, memberLoad = member.totalEquipmentLoad_;
+	if (makespan == memberMakespan && load == memberLoad)
+	{
+		return hasSmallerGenes(chromosome, member);
+	}
+	if (makespan <= memberMakespan && load <= memberLoad)
+	{
+		return true;
+	}
+	if (memberMakespan <= makespan && memberLoad <= load)
+	{
+		return false;
+	}
+	const double distance = cornerDistance(makespan, load), memberDistance = cornerDistance(memberMakespan, memberLoad);
+	return distance < memberDistance || (distance == memberDistance && hasSmallerGenes(chromosome, member));
+}
+
+template <typename Genes>
+double ParetoArchive<Genes>::cornerDistance(int makespan, int load) const
+{
+	// Relative distance to the lower corner of the box
+	const double makespanCorner = std::exp(box(makespan) * logBoxWidth_);
+	const double loadCorner = std::exp(box(load) * logBoxWidth_);
+	const double makespanOffset = makespan / makespanCorner - 1.0;
+	const double loadOffset = load / loadCorner - 1.0;
+	return makespanOffset * makespanOffset + loadOffset * loadOffset;
+}
+
+template <typename Genes>
+template <typename Chromosome>
+bool ParetoArchive<Genes>::hasSmallerGenes(const Chromosome& chromosome, const ArchiveMember<Genes>& member)
+{
+	const int numberOfGenes = member.numberOfGenes_;
+	if (std::lexicographical_compare(chromosome.processes_, chromosome.processes_ + numberOfGenes, member.processes_, member.processes_ + numberOfGenes))
+	{
+		return true;
+	}
+	return std::equal(chromosome.processes_, chromosome.processes_ + numberOfGenes, member.processes_) &&
+		   std::lexicographical_compare(chromosome.machines_, chromosome.machines_ + numberOfGenes, member.machines_, member.machines_ + numberOfGenes);
+}
+
+template <typename Genes>
+template <typename Target, typename Source>
+void ParetoArchive<Genes>::copyChromosome(Target& target, const Source& source)
+{
+	std::copy(source.processes_, source.processes_ + source.numberOfGenes_, target.processes_);
+	std::copy(source.machines_, source.machines_ + source.numberOfGenes_, target.machines_);
+	target.maxCompletionTime_ = source.maxCompletionTime_;
+	target.totalEquipmentLoad_ = source.totalEquipmentLoad_;
+	target.fitnessValid_ = true;
+}
+
+template <typename Genes>
+template <typename Chromosome>
+void ParetoArchive<Genes>::appendCopy(ChromosomePool<Chromosome>& out, const ArchiveMember<Genes>& member)
+{
+	out.resize(out.size() + 1);
+	copyChromosome(out[out.size() - 1], member);
+}
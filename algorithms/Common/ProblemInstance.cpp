@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+
+#include "ProblemInstance.h"
+#include "Job.cpp"
+
+ProblemInstance::ProblemInstance()
+{
+	jobOffsets_.push_back(0);
+	eligibleOffsets_.push_back(0);
+}
+
+ProblemInstance::ProblemInstance(const std::vector<Job>& jobs, int numberOfMachines)
+{
+	numberOfJobs_ = static_cast<int>(jobs.size());
+	numberOfMachines_ = numberOfMachines;
+
+	// The dataset may describe more machines than requested on the command line
+	for (const auto& job : jobs)
+	{
+		for (const auto& process : job.processes)
+		{
+			if (!process.machineDurations.empty())
+			{
+				numberOfMachines_ = std::max(numberOfMachines_, process.machineDurations.rbegin()->first + 1);
+			}
+		}
+	}
+
+	jobOffsets_.reserve(numberOfJobs_ + 1);
+	jobOffsets_.push_back(0);
+	for (int jobIndex = 0; jobIndex < numberOfJobs_; jobIndex++)
+	{
+		jobOffsets_.push_back(jobOffsets_.back() + static_cast<int>(jobs[jobIndex].processes.size()));
+	}
+	numberOfOperations_ = jobOffsets_.back();
+
+	operationJob_.resize(numberOfOperations_);
+	// Machines missing from a process description cannot run it
+	durations_.assign(static_cast<std::size_t>(numberOfOperations_) * numberOfMachines_, ineligibleDuration);
+
+	for (int jobIndex = 0; jobIndex < numberOfJobs_; jobIndex++)
+	{
+		const int numberOfProcesses = static_cast<int>(jobs[jobIndex].processes.size());
+		for (int processIndex = 0; processIndex < numberOfProcesses; processIndex++)
+		{
+			const int operation = operationId(jobIndex, processIndex);
+			operationJob_[operation] = jobIndex;
+
+			for (const auto& durationPair : jobs[jobIndex].processes[processIndex].machineDurations)
+			{
+				if (durationPair.first >= 0)
+				{
+					durations_[static_cast<std::size_t>(operation) * numberOfMachines_ + durationPair.first] = durationPair.second;
+				}
+			}
+		}
+	}
+
+	// Eligible machines of each operation, fastest first
+	eligibleOffsets_.reserve(numberOfOperations_ + 1);
+	eligibleOffsets_.push_back(0);
+	durationRanks_.assign(durations_.size(), -1);
+	for (int operation = 0; operation < numberOfOperations_; operation++)
+	{
+		const int first = static_cast<int>(eligibleMachines_.size());
+		for (int machineIndex = 0; machineIndex < numberOfMachines_; machineIndex++)
+		{
+			if (isEligible(operation, machineIndex))
+			{
+				eligibleMachines_.push_back(machineIndex);
+			}
+		}
+
+		const int* operationRow = operationDurations(operation);
+		std::stable_sort(eligibleMachines_.begin() + first, eligibleMachines_.end(),
+			[operationRow](int a, int b) -> bool
+			{
+				return operationRow[a] < operationRow[b];
+			});
+
+		for (int index = first; index < static_cast<int>(eligibleMachines_.size()); index++)
+		{
+			durationRanks_[static_cast<std::size_t>(operation) * numberOfMachines_ + eligibleMachines_[index]] = index - first;
+		}
+		eligibleOffsets_.push_back(static_cast<int>(eligibleMachines_.size()));
+	}
+}
+
+int ProblemInstance::unschedulableOperation() const
+{
+	for (int operation = 0; operation < numberOfOperations_; operation++)
+	{
+		if (eligibleCount(operation) == 0)
+		{
+			return operation;
+		}
+	}
+
+	return -1;
+}
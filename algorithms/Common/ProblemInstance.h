@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+
+#include "Job.h"
+
+// Flat, read-only view of a problem instance shared by both solvers.
+// Operations get dense ids in job-major order (all operations of job 0,
+// then job 1, ...) and their durations live in one row-major
+// operation x machine matrix, so a lookup is a single indexed load.
+class ProblemInstance
+{
+public:
+	// Duration used by the datasets to mark a machine that cannot run an operation
+	static constexpr int ineligibleDuration = 100;
+
+	ProblemInstance();
+	ProblemInstance(const std::vector<Job>& jobs, int numberOfMachines);
+
+	int numberOfJobs() const { return numberOfJobs_; }
+	int numberOfMachines() const { return numberOfMachines_; }
+	int numberOfOperations() const { return numberOfOperations_; }
+
+	// Number of operations of a job and the dense id of its first one
+	int jobLength(int jobIndex) const { return jobOffsets_[jobIndex + 1] - jobOffsets_[jobIndex]; }
+	int jobOffset(int jobIndex) const { return jobOffsets_[jobIndex]; }
+
+	int operationId(int jobIndex, int processIndex) const { return jobOffsets_[jobIndex] + processIndex; }
+	int jobOfOperation(int operationId) const { return operationJob_[operationId]; }
+
+	int duration(int operationId, int machineIndex) const
+	{
+		return durations_[static_cast<std::size_t>(operationId) * numberOfMachines_ + machineIndex];
+	}
+
+	// Row of the duration matrix for one operation (numberOfMachines() entries)
+	const int* operationDurations(int operationId) const
+	{
+		return durations_.data() + static_cast<std::size_t>(operationId) * numberOfMachines_;
+	}
+
+	bool isEligible(int operationId, int machineIndex) const
+	{
+		return duration(operationId, machineIndex) != ineligibleDuration;
+	}
+
+	// Machines that can run an operation, fastest first (ties by machine index),
+	// so a uniform eligible machine is eligibleMachine(operation, draw % eligibleCount(operation))
+	int eligibleCount(int operationId) const { return eligibleOffsets_[operationId + 1] - eligibleOffsets_[operationId]; }
+	int eligibleMachine(int operationId, int index) const { return eligibleMachines_[eligibleOffsets_[operationId] + index]; }
+
+	// Position of a machine in the operation's eligible list, -1 if it cannot run it
+	int durationRank(int operationId, int machineIndex) const
+	{
+		return durationRanks_[static_cast<std::size_t>(operationId) * numberOfMachines_ + machineIndex];
+	}
+
+	// First operation no machine can run, -1 when every operation can be scheduled
+	int unschedulableOperation() const;
+
+private:
+	int numberOfJobs_ = 0;
+	int numberOfMachines_ = 0;
+	int numberOfOperations_ = 0;
+
+	std::vector<int> jobOffsets_;	// <jobIndex, first operation id>, numberOfJobs_ + 1 entries
+	std::vector<int> operationJob_;	// <operation id, jobIndex>
+	std::vector<int> durations_;	// numberOfOperations_ x numberOfMachines_
+
+	std::vector<int> eligibleOffsets_;	// <operation id, first entry in eligibleMachines_>, numberOfOperations_ + 1 entries
+	std::vector<int> eligibleMachines_;	// machine indexes of each operation, by duration
+	std::vector<int> durationRanks_;	// numberOfOperations_ x numberOfMachines_
+};
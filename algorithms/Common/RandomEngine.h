@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+// Independent streams derived from the seed of a run
+enum RandomStream : std::uint64_t
+{
+	JobGenerationStream = 1,
+	SolverStream = 2,
+	CoralReefStream = 3, // the CRO engine of the hybrid solver, next to NSGA-II on SolverStream
+	IslandStream = 1 << 16, // island i draws from IslandStream + i
+	TileStream = 1 << 17 // reef tile i draws from TileStream + i
+};
+
+// xoshiro256** generator. Four words of state and a few cycles per draw; it
+// satisfies UniformRandomBitGenerator, so it works with the <random>
+// distributions and std::shuffle. Equal (seed, stream) pairs give equal
+// sequences, which is what makes a run reproducible from its --seed.
+class RandomEngine
+{
+public:
+	using result_type = std::uint64_t;
+
+	RandomEngine() { seed(0); }
+	explicit RandomEngine(std::uint64_t seedValue, std::uint64_t stream = 0) { seed(seedValue, stream); }
+
+	// The state is expanded with splitmix64, with the stream folded into its start
+	void seed(std::uint64_t seedValue, std::uint64_t stream = 0)
+	{
+		std::uint64_t streamKey = stream;
+		std::uint64_t mixer = seedValue ^ splitMix64(streamKey);
+		for (auto& word : state_)
+		{
+			word = splitMix64(mixer);
+		}
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	result_type operator()()
+	{
+		const std::uint64_t result = rotateLeft(state_[1] * 5, 7) * 9;
+		const std::uint64_t shifted = state_[1] << 17;
+
+		state_[2] ^= state_[0];
+		state_[3] ^= state_[1];
+		state_[1] ^= state_[2];
+		state_[0] ^= state_[3];
+		state_[2] ^= shifted;
+		state_[3] = rotateLeft(state_[3], 45);
+
+		return result;
+	}
+
+private:
+	static std::uint64_t rotateLeft(std::uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	static std::uint64_t splitMix64(std::uint64_t& value)
+	{
+		std::uint64_t z = (value += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	std::uint64_t state_[4];
+};
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "ScheduleDecoder.h"
+#include "FitnessCache.cpp"
+
+ScheduleDecoder::ScheduleDecoder() {}
+
+ScheduleDecoder::ScheduleDecoder(const ProblemInstance& instance)
+	: instance_(&instance),
+	  machineClock_(instance.numberOfMachines(), 0),
+	  jobClock_(instance.numberOfJobs(), 0),
+	  nextOperation_(instance.numberOfJobs(), 0),
+	  laneMachineClock_(static_cast<std::size_t>(instance.numberOfMachines()) * batchWidth, 0),
+	  laneJobClock_(static_cast<std::size_t>(instance.numberOfJobs()) * batchWidth, 0),
+	  laneNextOperation_(static_cast<std::size_t>(instance.numberOfJobs()) * batchWidth, 0),
+	  laneJobSlot_(static_cast<std::size_t>(instance.numberOfOperations()) * batchWidth, 0),
+	  laneMachineSlot_(static_cast<std::size_t>(instance.numberOfOperations()) * batchWidth, 0),
+	  laneDurationIndex_(static_cast<std::size_t>(instance.numberOfOperations()) * batchWidth, 0)
+{
+	stateSize_ = instance.numberOfMachines() + 2 * instance.numberOfJobs();
+}
+
+void ScheduleDecoder::resetClocks()
+{
+	const ProblemInstance& instance = *instance_;
+
+	std::fill(machineClock_.begin(), machineClock_.end(), 0);
+	std::fill(jobClock_.begin(), jobClock_.end(), 0);
+	for (int jobIndex = 0; jobIndex < instance.numberOfJobs(); jobIndex++)
+	{
+		nextOperation_[jobIndex] = instance.jobOffset(jobIndex);
+	}
+}
+
+Fitness ScheduleDecoder::evaluate(const std::vector<int>& processes, const std::vector<int>& machines)
+{
+	const ProblemInstance& instance = *instance_;
+
+	resetClocks();
+
+	const int numberOfGenes = static_cast<int>(processes.size());
+	for (int gene = 0; gene < numberOfGenes; gene++)
+	{
+		const int jobIndex = processes[gene] - 1;
+		const int machineIndex = machines[gene] - 1;
+		const int operation = nextOperation_[jobIndex]++;
+
+		// The operation starts once both its job and its machine are free
+		const int finishTime = std::max(jobClock_[jobIndex], machineClock_[machineIndex]) + instance.duration(operation, machineIndex);
+		jobClock_[jobIndex] = finishTime;
+		machineClock_[machineIndex] = finishTime;
+	}
+
+	return machineClockFitness();
+}
+
+Fitness ScheduleDecoder::machineClockFitness() const
+{
+	Fitness fitness;
+	for (int machineTime : machineClock_)
+	{
+		fitness.maxCompletionTime = std::max(fitness.maxCompletionTime, machineTime);
+		fitness.totalEquipmentLoad += machineTime;
+	}
+
+	return fitness;
+}
+
+template <typename Genes>
+void ScheduleDecoder::evaluateAll(const ChromosomeRef<Genes>* chromosomes, int count, Fitness* fitness)
+{
+	missIndex_.clear();
+	if (cache_ == nullptr)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			missIndex_.push_back(i);
+		}
+		decodeAll(chromosomes, missIndex_.data(), count, fitness);
+		return;
+	}
+
+	const int numberOfGenes = instance_->numberOfOperations();
+
+	// Answer chromosomes seen before from the cache and decode only the misses
+	missKeys_.clear();
+	for (int i = 0; i < count; i++)
+	{
+		const std::uint64_t key = FitnessCache::hash(chromosomes[i], numberOfGenes);
+		if (cache_->find(key, fitness[i]))
+		{
+			continue;
+		}
+		missIndex_.push_back(i);
+		missKeys_.push_back(key);
+	}
+
+	decodeAll(chromosomes, missIndex_.data(), static_cast<int>(missIndex_.size()), fitness);
+
+	for (std::size_t miss = 0; miss < missIndex_.size(); miss++)
+	{
+		cache_->insert(missKeys_[miss], fitness[missIndex_[miss]]);
+	}
+}
+
+template <typename Genes>
+void ScheduleDecoder::decodeAll(const ChromosomeRef<Genes>* chromosomes, const int* indices, int count, Fitness* fitness)
+{
+	// Resume locally changed chromosomes from a checkpoint, batch the rest
+	fullIndex_.clear();
+	for (int i = 0; i < count; i++)
+	{
+		const int index = indices[i];
+		if (canResume(chromosomes[index].checkpoints))
+		{
+			fitness[index] = resumeFromCheckpoint(chromosomes[index]);
+			continue;
+		}
+		fullIndex_.push_back(index);
+	}
+
+	const int fullCount = static_cast<int>(fullIndex_.size());
+	for (int first = 0; first < fullCount; first += batchWidth)
+	{
+		evaluateBatch(chromosomes, fullIndex_.data() + first, std::min(batchWidth, fullCount - first), fitness);
+	}
+}
+
+bool ScheduleDecoder::canResume(const DecoderCheckpoints* checkpoints) const
+{
+	return checkpoints != nullptr &&
+		   checkpoints->holdsState() &&
+		   checkpoints->state.size() == static_cast<std::size_t>(stateSize_);
+}
+
+template <typename Genes>
+void ScheduleDecoder::decodeGenes(const ChromosomeRef<Genes>& chromosome, int first, int end)
+{
+	const ProblemInstance& instance = *instance_;
+
+	for (int gene = first; gene < end; gene++)
+	{
+		const int jobIndex = chromosome.processes[gene] - 1;
+		const int machineIndex = chromosome.machines[gene] - 1;
+		const int operation = nextOperation_[jobIndex]++;
+
+		const int finishTime = std::max(jobClock_[jobIndex], machineClock_[machineIndex]) + instance.duration(operation, machineIndex);
+		jobClock_[jobIndex] = finishTime;
+		machineClock_[machineIndex] = finishTime;
+	}
+}
+
+template <typename Genes>
+void ScheduleDecoder::savePrefix(const ChromosomeRef<Genes>& chromosome, int gene, DecoderCheckpoints& checkpoints)
+{
+	const int numberOfMachines = instance_->numberOfMachines();
+	const int numberOfJobs = instance_->numberOfJobs();
+
+	resetClocks();
+	decodeGenes(chromosome, 0, gene);
+
+	checkpoints.state.resize(stateSize_);
+	std::copy(machineClock_.begin(), machineClock_.end(), checkpoints.state.begin());
+	std::copy(jobClock_.begin(), jobClock_.end(), checkpoints.state.begin() + numberOfMachines);
+	std::copy(nextOperation_.begin(), nextOperation_.end(), checkpoints.state.begin() + numberOfMachines + numberOfJobs);
+	checkpoints.gene = gene;
+}
+
+template <typename Genes>
+Fitness ScheduleDecoder::resumeFromCheckpoint(const ChromosomeRef<Genes>& chromosome)
+{
+	const int numberOfMachines = instance_->numberOfMachines();
+	const int numberOfJobs = instance_->numberOfJobs();
+	DecoderCheckpoints& checkpoints = *chromosome.checkpoints;
+
+	const int* state = checkpoints.state.data();
+	std::copy(state, state + numberOfMachines, machineClock_.begin());
+	std::copy(state + numberOfMachines, state + numberOfMachines + numberOfJobs, jobClock_.begin());
+	std::copy(state + numberOfMachines + numberOfJobs, state + stateSize_, nextOperation_.begin());
+
+	decodeGenes(chromosome, checkpoints.gene, instance_->numberOfOperations());
+	// The state described the chromosome before it was evaluated
+	checkpoints.gene = 0;
+
+	return machineClockFitness();
+}
+
+template <typename Genes>
+void ScheduleDecoder::evaluateBatch(const ChromosomeRef<Genes>* chromosomes, const int* indices, int count, Fitness* fitness)
+{
+	const ProblemInstance& instance = *instance_;
+	const int numberOfGenes = instance.numberOfOperations();
+	const int numberOfMachines = instance.numberOfMachines();
+	const int numberOfJobs = instance.numberOfJobs();
+
+	// Transpose the batch into gene-major lanes and resolve operation ids.
+	// Lanes past count repeat the last chromosome so the kernel stays branch-free.
+	for (int jobIndex = 0; jobIndex < numberOfJobs; jobIndex++)
+	{
+		std::fill_n(laneNextOperation_.begin() + jobIndex * batchWidth, batchWidth, instance.jobOffset(jobIndex));
+	}
+	for (int lane = 0; lane < batchWidth; lane++)
+	{
+		const ChromosomeRef<Genes>& chromosome = chromosomes[indices[std::min(lane, count - 1)]];
+		for (int gene = 0; gene < numberOfGenes; gene++)
+		{
+			const int jobIndex = chromosome.processes[gene] - 1;
+			const int machineIndex = chromosome.machines[gene] - 1;
+			const int operation = laneNextOperation_[jobIndex * batchWidth + lane]++;
+
+			laneJobSlot_[gene * batchWidth + lane] = jobIndex * batchWidth + lane;
+			laneMachineSlot_[gene * batchWidth + lane] = machineIndex * batchWidth + lane;
+			laneDurationIndex_[gene * batchWidth + lane] = operation * numberOfMachines + machineIndex;
+		}
+	}
+
+	Fitness laneFitness[batchWidth];
+	runBatch(count, laneFitness);
+	for (int lane = 0; lane < count; lane++)
+	{
+		fitness[indices[lane]] = laneFitness[lane];
+	}
+}
+
+void ScheduleDecoder::runBatch(int count, Fitness* fitness)
+{
+	const ProblemInstance& instance = *instance_;
+	const int numberOfGenes = instance.numberOfOperations();
+	const int numberOfMachines = instance.numberOfMachines();
+
+	std::fill(laneMachineClock_.begin(), laneMachineClock_.end(), 0);
+	std::fill(laneJobClock_.begin(), laneJobClock_.end(), 0);
+
+	int* jobClock = laneJobClock_.data();
+	int* machineClock = laneMachineClock_.data();
+	const int* durations = instance.operationDurations(0);
+#if defined(__AVX512F__)
+	// Padding lanes are masked off; the masked forms take a zero source instead of an undefined one
+	const __mmask16 activeLanes = static_cast<__mmask16>((1u << count) - 1);
+	const __m512i zero = _mm512_setzero_si512();
+#endif
+
+	// finish = max(jobClock, machineClock) + duration, for every lane at once.
+	// Lanes never share a slot, so the scatters cannot conflict.
+	for (int gene = 0; gene < numberOfGenes; gene++)
+	{
+		const int* jobSlot = laneJobSlot_.data() + gene * batchWidth;
+		const int* machineSlot = laneMachineSlot_.data() + gene * batchWidth;
+		const int* durationIndex = laneDurationIndex_.data() + gene * batchWidth;
+
+#if defined(__AVX512F__)
+		const __m512i jobSlots = _mm512_maskz_loadu_epi32(activeLanes, jobSlot);
+		const __m512i machineSlots = _mm512_maskz_loadu_epi32(activeLanes, machineSlot);
+		const __m512i durationIndices = _mm512_maskz_loadu_epi32(activeLanes, durationIndex);
+		const __m512i jobTime = _mm512_mask_i32gather_epi32(zero, activeLanes, jobSlots, jobClock, 4);
+		const __m512i machineTime = _mm512_mask_i32gather_epi32(zero, activeLanes, machineSlots, machineClock, 4);
+		const __m512i duration = _mm512_mask_i32gather_epi32(zero, activeLanes, durationIndices, durations, 4);
+		const __m512i finishTime = _mm512_add_epi32(_mm512_maskz_max_epi32(activeLanes, jobTime, machineTime), duration);
+		_mm512_mask_i32scatter_epi32(jobClock, activeLanes, jobSlots, finishTime, 4);
+		_mm512_mask_i32scatter_epi32(machineClock, activeLanes, machineSlots, finishTime, 4);
+#elif defined(__AVX2__)
+		alignas(32) int finishTime[batchWidth];
+		const __m256i jobTime = _mm256_i32gather_epi32(jobClock, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(jobSlot)), 4);
+		const __m256i machineTime = _mm256_i32gather_epi32(machineClock, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(machineSlot)), 4);
+		const __m256i duration = _mm256_i32gather_epi32(durations, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(durationIndex)), 4);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(finishTime), _mm256_add_epi32(_mm256_max_epi32(jobTime, machineTime), duration));
+		// AVX2 has no scatter
+		for (int lane = 0; lane < batchWidth; lane++)
+		{
+			jobClock[jobSlot[lane]] = finishTime[lane];
+			machineClock[machineSlot[lane]] = finishTime[lane];
+		}
+#else
+		for (int lane = 0; lane < batchWidth; lane++)
+		{
+			const int finishTime = std::max(jobClock[jobSlot[lane]], machineClock[machineSlot[lane]]) + durations[durationIndex[lane]];
+			jobClock[jobSlot[lane]] = finishTime;
+			machineClock[machineSlot[lane]] = finishTime;
+		}
+#endif
+	}
+
+	// Reduce the machine clocks of every lane; rows are contiguous per machine
+	int maxCompletionTime[batchWidth] = {};
+	int totalEquipmentLoad[batchWidth] = {};
+	for (int machineIndex = 0; machineIndex < numberOfMachines; machineIndex++)
+	{
+		const int* machineTime = machineClock + machineIndex * batchWidth;
+		for (int lane = 0; lane < batchWidth; lane++)
+		{
+			maxCompletionTime[lane] = std::max(maxCompletionTime[lane], machineTime[lane]);
+			totalEquipmentLoad[lane] += machineTime[lane];
+		}
+	}
+
+	for (int lane = 0; lane < count; lane++)
+	{
+		fitness[lane].maxCompletionTime = maxCompletionTime[lane];
+		fitness[lane].totalEquipmentLoad = totalEquipmentLoad[lane];
+	}
+}
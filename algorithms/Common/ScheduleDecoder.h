@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "ProblemInstance.h"
+#include "GeneEncoding.h"
+
+class FitnessCache;
+
+struct Fitness
+{
+	int maxCompletionTime = 0;
+	int totalEquipmentLoad = 0;
+};
+
+// Decoder state in front of one gene of a chromosome, so a decode after a
+// change at or past that gene resumes there instead of from gene 0. Only a
+// chromosome waiting for its evaluation after a mutation holds one.
+struct DecoderCheckpoints
+{
+	std::vector<int> state;	// machine clocks, job clocks, next operations
+	int gene = 0;			// the state is in front of this gene, 0 when there is none
+
+	bool holdsState() const { return gene > 0; }
+	// A gene at position changedGene was changed
+	void invalidateFrom(int changedGene) { gene = changedGene < gene ? 0 : gene; }
+};
+
+// Non-owning view of one chromosome (1-based job ids and machine ids).
+// With a state attached, the decoder resumes from it and then drops it.
+template <typename Genes>
+struct ChromosomeRef
+{
+	const typename Genes::JobGene* processes = nullptr;
+	const typename Genes::MachineGene* machines = nullptr;
+	DecoderCheckpoints* checkpoints = nullptr;
+};
+
+// Decodes a (process, machine) chromosome into its schedule objectives.
+// Scratch buffers are sized once for the instance and reused, so an
+// evaluation does not allocate. A decoder is not thread-safe; use one per thread.
+//
+// evaluateAll() decodes batchWidth chromosomes in lockstep: the clocks are
+// kept as structure-of-arrays lanes (clock[index * batchWidth + lane]) so the
+// max/add of the recurrence runs on a whole batch per gene. Build with
+// -mavx2 / -mavx512f (or /arch:AVX2, /arch:AVX512) to get the vector kernels;
+// otherwise a portable lane loop is used.
+class ScheduleDecoder
+{
+public:
+#if defined(__AVX512F__)
+	static constexpr int batchWidth = 16;
+#else
+	static constexpr int batchWidth = 8;
+#endif
+
+	ScheduleDecoder();
+	explicit ScheduleDecoder(const ProblemInstance& instance);
+
+	// processes hold 1-based job ids, machines 1-based machine ids
+	Fitness evaluate(const std::vector<int>& processes, const std::vector<int>& machines);
+
+	// Evaluates count chromosomes, batchWidth at a time. With a cache attached,
+	// chromosomes seen before are answered from it and only misses are decoded.
+	// Chromosomes holding a state are resumed from it one at a time.
+	template <typename Genes>
+	void evaluateAll(const ChromosomeRef<Genes>* chromosomes, int count, Fitness* fitness);
+
+	// Decodes genes [0, gene) of chromosome and keeps the state in front of gene
+	template <typename Genes>
+	void savePrefix(const ChromosomeRef<Genes>& chromosome, int gene, DecoderCheckpoints& checkpoints);
+
+	void setCache(FitnessCache* cache) { cache_ = cache; }
+
+private:
+	// The chromosomes at indices[0, count) are decoded into fitness[indices[i]]
+	template <typename Genes>
+	void decodeAll(const ChromosomeRef<Genes>* chromosomes, const int* indices, int count, Fitness* fitness);
+	template <typename Genes>
+	void evaluateBatch(const ChromosomeRef<Genes>* chromosomes, const int* indices, int count, Fitness* fitness);
+	void runBatch(int count, Fitness* fitness);
+	template <typename Genes>
+	Fitness resumeFromCheckpoint(const ChromosomeRef<Genes>& chromosome);
+
+	bool canResume(const DecoderCheckpoints* checkpoints) const;
+	void resetClocks();
+	// Scalar decode of genes [first, end) on the current clocks
+	template <typename Genes>
+	void decodeGenes(const ChromosomeRef<Genes>& chromosome, int first, int end);
+	Fitness machineClockFitness() const;
+
+	const ProblemInstance* instance_ = nullptr;
+	FitnessCache* cache_ = nullptr;
+
+	int stateSize_ = 0;	// machines + 2 * jobs
+
+	std::vector<int> machineClock_;		// <machineIndex, machine available time>
+	std::vector<int> jobClock_;			// <jobIndex, job current time>
+	std::vector<int> nextOperation_;	// <jobIndex, operation id of the job's next gene>
+
+	// Batch lanes: clocks are [index * batchWidth + lane]
+	std::vector<int> laneMachineClock_;
+	std::vector<int> laneJobClock_;
+	std::vector<int> laneNextOperation_;
+
+	// Transposed batch genes: [gene * batchWidth + lane]
+	std::vector<int> laneJobSlot_;			// jobIndex * batchWidth + lane
+	std::vector<int> laneMachineSlot_;		// machineIndex * batchWidth + lane
+	std::vector<int> laneDurationIndex_;	// operation id * numberOfMachines + machineIndex
+
+	// Cache misses of the current evaluateAll call
+	std::vector<int> missIndex_;
+	std::vector<std::uint64_t> missKeys_;
+
+	// Chromosomes of the current decodeAll call that need a full decode
+	std::vector<int> fullIndex_;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "CommandLine.h"
+#include "Checkpoint.h"
+
+// Tuning knobs shared by both solvers, read from the optional command line flags
+struct SolverOptions
+{
+	int numberOfThreads = 1;
+	int fitnessCacheSize = 1 << 16; // slots, 0 disables the cache
+	// Re-decode mutated chromosomes from the mutation point: 1 on, 0 off,
+	// -1 on for instances of at most deltaEvaluationLimit operations, beyond
+	// which the state every brooded larva carries is not worth its memory
+	int deltaEvaluation = -1;
+	static constexpr int deltaEvaluationLimit = 4096;
+	bool compactGenes = true; // narrow gene integers when the instance fits them
+	std::uint64_t seed = 0; // every random draw of a run derives from it
+
+	// NSGA-II island model: sub-populations evolved in parallel, 1 keeps a single population
+	int numberOfIslands = 1;
+	// The two also pace the hybrid solver's exchanges through its shared archive
+	int migrationInterval = 10; // generations between migrations
+	int migrants = 2; // individuals each island sends per migration
+	std::string migrationTopology = "ring"; // ring, or random: a freshly shuffled ring every migration
+
+	// CRO reef bands spawned, evaluated and settled in parallel. A single tile is
+	// reproducible; with more tiles concurrent settlement depends on thread timing.
+	int reefTiles = 1;
+
+	// Relative box width of the Pareto archive's epsilon grid, 0 keeps the exact front
+	double archiveEpsilon = 0.0;
+
+	// Wall-clock budget in milliseconds; at the deadline the solvers report the best front so far. 0 has none.
+	int timeLimitMs = 0;
+
+	// Stop once the archive hypervolume has not grown by more than stagnationEpsilon
+	// (relative) for stagnationWindow generations. A window of 0 never stops.
+	int stagnationWindow = 0;
+	double stagnationEpsilon = 0.001;
+
+	// Solver state is saved to checkpointPath every checkpointInterval generations
+	// (0: only on SIGTERM), and a run started with resumePath goes on from there
+	std::string checkpointPath;
+	int checkpointInterval = 0;
+	std::string resumePath;
+
+	static SolverOptions fromCommandLine(const CommandLine& commandLine)
+	{
+		SolverOptions options;
+		options.numberOfThreads = commandLine.getInt("threads", std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+		options.fitnessCacheSize = commandLine.getInt("fitness-cache", options.fitnessCacheSize);
+		options.deltaEvaluation = commandLine.getInt("delta-evaluation", options.deltaEvaluation);
+		options.compactGenes = commandLine.getInt("compact-genes", 1) != 0;
+		options.checkpointPath = commandLine.getString("checkpoint", options.checkpointPath);
+		options.checkpointInterval = std::max(0, commandLine.getInt("checkpoint-interval", options.checkpointInterval));
+		options.resumePath = commandLine.getString("resume", options.resumePath);
+		// Without --seed a resumed run takes the checkpoint's and a new one draws a fresh one;
+		// the solvers report it so the run can be repeated
+		if (commandLine.has("seed"))
+		{
+			options.seed = std::stoull(commandLine.getString("seed", "0"));
+		}
+		else if (options.resumePath.empty() || !readCheckpointSeed(options.resumePath, options.seed))
+		{
+			options.seed = (static_cast<std::uint64_t>(std::random_device()()) << 32) | std::random_device()();
+		}
+		options.numberOfIslands = std::max(1, commandLine.getInt("islands", options.numberOfIslands));
+		options.migrationInterval = std::max(1, commandLine.getInt("migration-interval", options.migrationInterval));
+		options.migrants = std::max(0, commandLine.getInt("migrants", options.migrants));
+		options.migrationTopology = commandLine.getString("topology", options.migrationTopology);
+		options.reefTiles = std::max(1, commandLine.getInt("reef-tiles", options.reefTiles));
+		options.archiveEpsilon = std::max(0.0, commandLine.getDouble("archive-epsilon", options.archiveEpsilon));
+		options.timeLimitMs = std::max(0, commandLine.getInt("time-limit-ms", options.timeLimitMs));
+		options.stagnationWindow = std::max(0, commandLine.getInt("stagnation-window", options.stagnationWindow));
+		options.stagnationEpsilon = std::max(0.0, commandLine.getDouble("stagnation-epsilon", options.stagnationEpsilon));
+		return options;
+	}
+
+	// Why the solvers cannot run with these options, or nothing if they can
+	std::string invalidOption() const
+	{
+		if (migrationTopology != "ring" && migrationTopology != "random")
+		{
+			return "Unknown migration topology \"" + migrationTopology + "\", expected ring or random.";
+		}
+		return "";
+	}
+};
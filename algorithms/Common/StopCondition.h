@@ -0,0 +1,123 @@
+#pragma once
+#include <chrono>
+#include <ostream>
+#include <string>
+
+#include "SolverOptions.h"
+#include "Checkpoint.h"
+
+// Ends a run before its last generation, at the wall-clock deadline, once
+// the archive hypervolume stagnates or on SIGTERM. Solvers poll the
+// deadline between phases, which costs one steady_clock read; a copy keeps
+// the same deadline, so islands and co-evolving engines can each hold one.
+// Stagnation is judged by whoever records the generations of the whole run.
+class StopCondition
+{
+public:
+	enum class Reason
+	{
+		None,
+		TimeLimit,
+		Stagnation,
+		Terminated // SIGTERM, after saving a checkpoint
+	};
+
+	StopCondition() = default;
+
+	explicit StopCondition(const SolverOptions& options)
+		: hasDeadline_(options.timeLimitMs > 0),
+		  deadline_(std::chrono::steady_clock::now() + std::chrono::milliseconds(options.timeLimitMs)),
+		  stagnationWindow_(options.stagnationWindow),
+		  stagnationEpsilon_(options.stagnationEpsilon)
+	{
+	}
+
+	// Checks the clock; once it returns true it keeps doing so
+	bool shouldStop(int generation)
+	{
+		if (reason_ == Reason::None && hasDeadline_ && std::chrono::steady_clock::now() >= deadline_)
+		{
+			reason_ = Reason::TimeLimit;
+			generation_ = generation;
+		}
+		return reason_ != Reason::None;
+	}
+
+	// Called with the hypervolume after a generation, or after the last generation
+	// of a round. The run stagnates once stagnationWindow generations passed since
+	// the hypervolume last grew by more than stagnationEpsilon relative to its
+	// value at that time.
+	bool recordGeneration(int generation, long long hypervolume)
+	{
+		if (reason_ != Reason::None || stagnationWindow_ <= 0)
+		{
+			return stopped();
+		}
+
+		if (gainGeneration_ < 0 || hypervolume > baselineHypervolume_ * (1.0 + stagnationEpsilon_))
+		{
+			gainGeneration_ = generation;
+			baselineHypervolume_ = static_cast<double>(hypervolume);
+		}
+		else if (generation - gainGeneration_ >= stagnationWindow_)
+		{
+			reason_ = Reason::Stagnation;
+			generation_ = generation;
+		}
+		return stopped();
+	}
+
+	void terminate(int generation)
+	{
+		if (reason_ == Reason::None)
+		{
+			reason_ = Reason::Terminated;
+			generation_ = generation;
+		}
+	}
+
+	bool stopped() const { return reason_ != Reason::None; }
+
+	// A checkpoint carries the stagnation state; a resumed run gets a new deadline
+	void save(CheckpointWriter& out) const
+	{
+		out.write(gainGeneration_);
+		out.write(baselineHypervolume_);
+	}
+
+	void restore(CheckpointReader& in)
+	{
+		in.read(gainGeneration_);
+		in.read(baselineHypervolume_);
+	}
+
+	void report(std::ostream& out, const std::string& solverName) const
+	{
+		switch (reason_)
+		{
+		case Reason::None:
+			out << solverName << " ran every generation" << std::endl;
+			break;
+		case Reason::TimeLimit:
+			out << solverName << " stopped at the time limit in generation " << generation_ << std::endl;
+			break;
+		case Reason::Stagnation:
+			out << solverName << " stopped in generation " << generation_ << ": no hypervolume gain above "
+				<< stagnationEpsilon_ << " since generation " << gainGeneration_ << std::endl;
+			break;
+		case Reason::Terminated:
+			out << solverName << " stopped by SIGTERM after generation " << generation_ << std::endl;
+			break;
+		}
+	}
+
+private:
+	bool hasDeadline_ = false;
+	std::chrono::steady_clock::time_point deadline_;
+	int stagnationWindow_ = 0; // generations, 0 never stagnates
+	double stagnationEpsilon_ = 0.0;
+	int gainGeneration_ = -1; // last generation with a gain, -1 before the first record
+	double baselineHypervolume_ = 0.0; // hypervolume at that generation
+	Reason reason_ = Reason::None;
+	int generation_ = 0;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int numberOfThreads)
+{
+	for (int threadIndex = 1; threadIndex < std::max(numberOfThreads, 1); threadIndex++)
+	{
+		workers_.emplace_back(&ThreadPool::workerLoop, this, threadIndex);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	wakeWorkers_.notify_all();
+
+	for (auto& worker : workers_)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::parallelFor(int count, int grain, const Task& task)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	grain = std::max(grain, 1);
+	const int threads = size();
+	int chunkSize = (count + threads - 1) / threads;
+	chunkSize = ((chunkSize + grain - 1) / grain) * grain;
+
+	// Not worth waking anyone for a single chunk
+	if (workers_.empty() || chunkSize >= count)
+	{
+		task(0, count, 0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		task_ = &task;
+		count_ = count;
+		chunkSize_ = chunkSize;
+		pendingWorkers_ = static_cast<int>(workers_.size());
+		round_++;
+	}
+	wakeWorkers_.notify_all();
+
+	runChunk(0);
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	chunksDone_.wait(lock, [this] { return pendingWorkers_ == 0; });
+	task_ = nullptr;
+}
+
+void ThreadPool::workerLoop(int threadIndex)
+{
+	std::uint64_t seenRound = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			wakeWorkers_.wait(lock, [&] { return stopping_ || round_ != seenRound; });
+			if (stopping_)
+			{
+				return;
+			}
+			seenRound = round_;
+		}
+
+		runChunk(threadIndex);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			pendingWorkers_--;
+		}
+		chunksDone_.notify_one();
+	}
+}
+
+void ThreadPool::runChunk(int threadIndex)
+{
+	const int begin = threadIndex * chunkSize_;
+	const int end = std::min(count_, begin + chunkSize_);
+
+	if (begin < end)
+	{
+		(*task_)(begin, end, threadIndex);
+	}
+}
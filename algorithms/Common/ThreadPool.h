@@ -0,0 +1,44 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker pool. parallelFor() splits [0, count) into one contiguous
+// chunk per thread and blocks until every chunk is done; the calling thread
+// works on chunk 0. Chunk boundaries are multiples of grain, so threads that
+// write per-item results into a shared array touch disjoint cache lines.
+class ThreadPool
+{
+public:
+	using Task = std::function<void(int begin, int end, int threadIndex)>;
+
+	explicit ThreadPool(int numberOfThreads = 1);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+	void parallelFor(int count, int grain, const Task& task);
+
+private:
+	void workerLoop(int threadIndex);
+	void runChunk(int threadIndex);
+
+	std::vector<std::thread> workers_;
+
+	std::mutex mutex_;
+	std::condition_variable wakeWorkers_;
+	std::condition_variable chunksDone_;
+
+	const Task* task_ = nullptr;
+	int count_ = 0;
+	int chunkSize_ = 0;
+	int pendingWorkers_ = 0;
+	std::uint64_t round_ = 0;
+	bool stopping_ = false;
+};
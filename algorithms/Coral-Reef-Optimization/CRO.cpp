@@ -8,34 +8,90 @@
 #include <fstream>
 #include <sstream>
 #include <iterator>
+#include <unordered_map>
 
 #include "CRO.h"
 #include "Coral.h"
 #include "Coral.cpp"
-
-CRO::CRO() 
+#include "ReefOccupancy.cpp"
+#include "../Common/ScheduleDecoder.cpp"
+#include "../Common/ThreadPool.cpp"
+#include "../Common/SolverOptions.h"
+#include "../Common/FenwickTree.h"
+#include "../Common/JobLoader.cpp"
+#include "../Common/CrossoverEngine.cpp"
+
+template <typename Genes>
+CRO<Genes>::CRO() 
 {
 	numberOfJobs_ = numberOfMachines_ = numberOfProcesses_ = reefSize_ = generations_ = 0;
 }
 
-CRO::CRO(int numberOfJobs, int numberOfMachines, int numberOfProcesses, int reefSize, int generations, std::string useDefault) 
+template <typename Genes>
+CRO<Genes>::CRO(int numberOfJobs, int numberOfMachines, int numberOfProcesses, int reefSize, int generations, std::vector<Job> jobs, const SolverOptions& options) 
+	: options_(options), random_(options.seed, SolverStream), threadPool_(options.numberOfThreads)
 {
 	numberOfJobs_ = numberOfJobs;
 	numberOfMachines_ = numberOfMachines;
 	numberOfProcesses_ = numberOfProcesses;
 	reefSize_ = reefSize;
 	generations_ = generations;
-	useDefaultSample_ = useDefault;
+	jobs_ = std::move(jobs);
 }
 
-void CRO::run() 
+template <typename Genes>
+bool CRO<Genes>::run() 
 {
-	int generation = 1;
+	// Rerunning with --seed <seed> repeats this run
+	std::cerr << "CRO seed: " << options_.seed << std::endl;
 
-	initializePopulation();
+	stopCondition_ = StopCondition(options_);
+	convergence_ = std::make_unique<ConvergenceLog>("CRO", std::cerr);
+
+	int resumedGeneration = 0;
+	if (options_.resumePath.empty())
+	{
+		initializePopulation();
+	}
+	else
+	{
+		prepareInstance();
+		prepareReef();
+		if (!restoreCheckpoint(resumedGeneration))
+		{
+			return false;
+		}
+	}
+	if (!options_.checkpointPath.empty())
+	{
+		catchTermination();
+	}
 
-	while (generation < generations_) 
+	// Displaying the generated jobs and their processes
+	outputJobs(jobs_);
+
+	evolve(resumedGeneration + 1, generations_ - 1);
+
+	outputOptimalSolution();
+
+	stopCondition_.report(std::cerr, "CRO");
+	convergence_->printImprovements();
+	if (fitnessCache_)
+	{
+		fitnessCache_->printStatistics(std::cerr, "CRO");
+	}
+	return true;
+}
+
+template <typename Genes>
+void CRO<Genes>::evolve(int firstGeneration, int lastGeneration)
+{
+	for (int generation = firstGeneration; generation <= lastGeneration; generation++) 
 	{
+		if (stopCondition_.shouldStop(generation))
+		{
+			break;
+		}
 
 		// Begin sexual reproduction
 		sexualReproduction();
@@ -44,7 +100,13 @@ void CRO::run()
 		determineFitnessValue();
 
 		// Begin larvae settling
-		larvaSettling(waterLarvae_.size());
+		larvaSettling();
+
+		// The larvae have settled, so stopping here leaves a complete reef
+		if (stopCondition_.shouldStop(generation))
+		{
+			break;
+		}
 
 		// Calculate domination counts
 		calculateDominationCounts();
@@ -70,30 +132,115 @@ void CRO::run()
 		// Cleanup old values
 		cleanupOldValues();
 
-		generation++;
+		if (convergence_)
+		{
+			convergence_->record(generation, archive_->hypervolume(), archive_->size());
+			if (stopCondition_.recordGeneration(generation, archive_->hypervolume()))
+			{
+				break;
+			}
+		}
 
+		// Saved every checkpointInterval generations, and before stopping on SIGTERM
+		if (!options_.checkpointPath.empty())
+		{
+			const bool terminating = terminationRequested != 0;
+			if (terminating || (options_.checkpointInterval > 0 && generation % options_.checkpointInterval == 0))
+			{
+				saveCheckpoint(generation);
+			}
+			if (terminating)
+			{
+				stopCondition_.terminate(generation);
+				break;
+			}
+		}
 	}
+}
 
-	outputOptimalSolution();
+template <typename Genes>
+void CRO<Genes>::prepareCoevolution(std::uint64_t stream)
+{
+	random_.seed(options_.seed, stream);
+	initializePopulation();
 }
 
-void CRO::initializePopulation() 
+template <typename Genes>
+int CRO<Genes>::offerToArchive(ParetoArchive<Genes>& archive)
 {
-	// Generate jobs
-	if (useDefaultSample_.size() == 1) {
-		if (std::stoi(useDefaultSample_) == 1) 
-		{
-			jobs_ = importDefaultSample();
-		} 
-		else 
+	return archive_->offerMembers(archive);
+}
+
+template <typename Genes>
+void CRO<Genes>::importFromArchive(const ParetoArchive<Genes>& archive, int count)
+{
+	// Archive members are released as larvae and settle like buds
+	CoralPool<Genes>& larvae = tiles_[0].larvae;
+	larvae.clear();
+	archive.sample(larvae, count, random_);
+	for (int i = 0; i < larvae.size(); i++) 
+	{
+		larvae[i].checkpoints_.invalidateFrom(0);
+		larvae[i].dominationCount_ = 0;
+	}
+
+	larvaSettling();
+}
+
+template <typename Genes>
+void CRO<Genes>::prepareInstance()
+{
+	instance_ = ProblemInstance(jobs_, numberOfMachines_);
+	decoders_.assign(threadPool_.size(), ScheduleDecoder(instance_));
+	crossovers_.assign(threadPool_.size(), CrossoverEngine(instance_));
+	deltaEvaluation_ = options_.deltaEvaluation < 0 ? instance_.numberOfOperations() <= SolverOptions::deltaEvaluationLimit : options_.deltaEvaluation != 0;
+	archive_ = std::make_unique<ParetoArchive<Genes>>(instance_.numberOfOperations(), options_.archiveEpsilon);
+	if (options_.fitnessCacheSize > 0)
+	{
+		fitnessCache_ = std::make_unique<FitnessCache>(options_.fitnessCacheSize);
+		for (auto& decoder : decoders_)
 		{
-			jobs_ = generateJobs(numberOfJobs_, numberOfMachines_, numberOfProcesses_);
+			decoder.setCache(fitnessCache_.get());
 		}
-	} else {
-		jobs_ = importDefaultSample(useDefaultSample_);
 	}
+}
 
-	outputJobs(jobs_);
+template <typename Genes>
+void CRO<Genes>::prepareReef()
+{
+	// One slot per cell; every generation produces at most one larva per coral
+	const int totalElements = reefSize_ * reefSize_;
+	reef_ = CoralPool<Genes>(instance_.numberOfOperations());
+	reef_.resize(totalElements);
+	occupancy_.reset(totalElements);
+	cellStates_ = std::vector<std::atomic<std::uint64_t>>(totalElements);
+	for (auto& state : cellStates_)
+	{
+		state.store(emptyCell, std::memory_order_relaxed);
+	}
+
+	// Tiles are bands of whole rows, each with its own random stream
+	const int numberOfTiles = std::min(options_.reefTiles, reefSize_);
+	tiles_.clear();
+	tiles_.resize(numberOfTiles);
+	rowTiles_.resize(reefSize_);
+	for (int t = 0; t < numberOfTiles; t++)
+	{
+		ReefTile& tile = tiles_[t];
+		tile.firstCell = (t * reefSize_ / numberOfTiles) * reefSize_;
+		tile.endCell = ((t + 1) * reefSize_ / numberOfTiles) * reefSize_;
+		std::fill(rowTiles_.begin() + tile.firstCell / reefSize_, rowTiles_.begin() + tile.endCell / reefSize_, t);
+		tile.random.seed(options_.seed, TileStream + t);
+		tile.larvae = CoralPool<Genes>(instance_.numberOfOperations());
+		tile.larvae.resize(tile.endCell - tile.firstCell);
+		tile.larvae.clear();
+	}
+}
+
+template <typename Genes>
+void CRO<Genes>::initializePopulation() 
+{
+	prepareInstance();
 
 	// Initialize population
 
@@ -105,8 +252,8 @@ void CRO::initializePopulation()
 
 	for (int i = 0; i < occupationCount; i++) 
 	{
-        int row = std::rand() % reefSize_;
-        int col = std::rand() % reefSize_;
+        int row = random_() % reefSize_;
+        int col = random_() % reefSize_;
 
         // Check if the element is already 1, if not, set it to 1
         if (binaryMaskMatrix[row][col] != 1) {
@@ -116,429 +263,369 @@ void CRO::initializePopulation()
         }
     }
 	
-	reef_.resize(reefSize_, std::vector<CoralPtr>(reefSize_));
+	prepareReef();
 
 	// Fill the reef with corals
     for (int i = 0; i < reefSize_; i++) 
 	{
         for (int j = 0; j < reefSize_; j++) 
 		{
-			CoralPtr coral = std::make_shared<Coral>(jobs_, numberOfProcesses_, numberOfMachines_, i*j-i);
 			if (binaryMaskMatrix[i][j] == 1) 
 			{
-            	reef_[i][j] = coral;
-				currentPopulation_.push_back(std::make_pair(i, j));
+				reef_[i * reefSize_ + j].initialize(instance_, random_);
+				occupancy_.occupy(i * reefSize_ + j);
 			}
         }
     }
-}
-
-void CRO::sexualReproduction() 
-{
-	// Shuffle the processes using a random engine
-    std::random_device rd;
-
-    // Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
 
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count();
-
-    // Initialize the random engine with the combined seed
-    std::mt19937 gen(seed);
-
-	int broadcastCount = (currentPopulation_.size() * reproductionFactor_) / 100;
+	// The hypervolume reference point is fixed from the initial reef
+	determineFitnessValue();
+	archive_->fixReferencePoint();
 
-	broadcastCount = (broadcastCount%2==0?broadcastCount:broadcastCount-1);
+	for (int i = 0; i < occupancy_.occupiedCount(); i++)
+	{
+		const int cell = occupancy_.occupiedCell(i);
+		cellStates_[cell].store(objectiveKey(reef_[cell]), std::memory_order_relaxed);
+	}
+}
 
-	std::shuffle(currentPopulation_.begin(), currentPopulation_.end(), gen);
+template <typename Genes>
+void CRO<Genes>::vacateCell(int cell)
+{
+	occupancy_.vacate(cell);
+	cellStates_[cell].store(emptyCell, std::memory_order_relaxed);
+}
 
-	for (auto i = 0; i < broadcastCount; i+=2) 
+template <typename Genes>
+void CRO<Genes>::sexualReproduction() 
+{
+	// Corals mate within their tile
+	for (ReefTile& tile : tiles_)
 	{
-		int coralRow1 = currentPopulation_[i].first;
-		int coralCol1 = currentPopulation_[i].second;
-		int coralRow2 = currentPopulation_[i+1].first;
-		int coralCol2 = currentPopulation_[i+1].second;
-		broadcastSpawning(reef_[coralRow1][coralCol1], reef_[coralRow2][coralCol2]);
+		tile.cells.clear();
 	}
-
-	for (auto i = broadcastCount; i < currentPopulation_.size(); i++) 
+	for (int i = 0; i < occupancy_.occupiedCount(); i++)
 	{
-		int coralRow = currentPopulation_[i].first;
-		int coralCol = currentPopulation_[i].second;
-		broodingMutation(reef_[coralRow][coralCol]);
+		const int cell = occupancy_.occupiedCell(i);
+		tileOf(cell).cells.push_back(cell);
 	}
-}
 
-void CRO::broadcastSpawning(const CoralPtr& parent1, const CoralPtr& parent2) 
-{
-	std::srand(unsigned(std::time(0)));
-	std::vector<int> firstGroup, secondGroup;
+	threadPool_.parallelFor(static_cast<int>(tiles_.size()), 1, [&](int begin, int end, int threadIndex)
+	{
+		for (int t = begin; t < end; t++)
+		{
+			ReefTile& tile = tiles_[t];
+			int broadcastCount = (static_cast<int>(tile.cells.size()) * reproductionFactor_) / 100;
 
-	splitJobs(firstGroup, secondGroup);
+			broadcastCount = (broadcastCount%2==0?broadcastCount:broadcastCount-1);
 
-	int i = 0, j = 0;
-	CoralPtr child = std::make_shared<Coral>();
+			std::shuffle(tile.cells.begin(), tile.cells.end(), tile.random);
 
-	while (i < numberOfProcesses_) 
-	{
-		int processGene1 = parent1->processes_[i];
-		int machineGene1 = parent1->machines_[i];
+			for (auto i = 0; i < broadcastCount; i+=2) 
+			{
+				broadcastSpawning(tile, crossovers_[threadIndex], reef_[tile.cells[i]], reef_[tile.cells[i+1]]);
+			}
 
-		if (std::count(firstGroup.begin(), firstGroup.end(), processGene1)) 
-		{		
-			child->processes_.push_back(processGene1);
-			child->machines_.push_back(machineGene1);
-			i++;
-		}
-		else 
-		{
-			bool found = false;
-			while (!found && j < numberOfProcesses_) {
-				int processGene2 = parent2->processes_[j];
-				int machineGene2 = parent2->machines_[j];
-				if (std::count(secondGroup.begin(), secondGroup.end(), processGene2)) 
-				{
-					child->processes_.push_back(processGene2);
-					child->machines_.push_back(machineGene2);
-					i++; j++;
-					found = true;
-				}
-				else 
-				{
-					j++;
-				}
+			for (auto i = broadcastCount; i < static_cast<int>(tile.cells.size()); i++) 
+			{
+				broodingMutation(tile, decoders_[threadIndex], reef_[tile.cells[i]]);
 			}
 		}
-	}
+	});
+}
+
+template <typename Genes>
+void CRO<Genes>::broadcastSpawning(ReefTile& tile, CrossoverEngine& crossover, const Coral<Genes>& parent1, const Coral<Genes>& parent2) 
+{
+	crossover.splitJobs(tile.random);
 
-	waterLarvae_.push_back(child);
+	tile.larvae.resize(tile.larvae.size() + 1);
+	Coral<Genes>& child = tile.larvae[tile.larvae.size() - 1];
+	child.maxCompletionTime_ = child.totalEquipmentLoad_ = 0;
+	child.fitnessValid_ = false;
+	child.checkpoints_.invalidateFrom(0);
+	child.dominationCount_ = 0;
+
+	crossover.jobBasedCrossover(parent1.processes_, parent1.machines_, parent2.processes_, parent2.machines_, true, child.processes_, child.machines_);
 }
 
-void CRO::broodingMutation(const CoralPtr& coral) 
+template <typename Genes>
+void CRO<Genes>::broodingMutation(ReefTile& tile, ScheduleDecoder& decoder, const Coral<Genes>& coral) 
 {
-	CoralPtr child = std::make_shared<Coral>(coral);
-	child->mutate(jobs_, numberOfMachines_);
+	tile.larvae.resize(tile.larvae.size() + 1);
+	Coral<Genes>& child = tile.larvae[tile.larvae.size() - 1];
+	child.copyFrom(coral);
+	child.dominationCount_ = 0;
+	const int mutatedGene = child.mutate(instance_, tile.random);
 
-	waterLarvae_.push_back(child);
+	// The genes in front of the mutation are the parent's, so is the decoder state there
+	if (deltaEvaluation_ && mutatedGene > 0)
+	{
+		decoder.savePrefix(ChromosomeRef<Genes>{child.processes_, child.machines_, nullptr}, mutatedGene, child.checkpoints_);
+	}
 }
 
-void CRO::determineFitnessValue() 
+template <typename Genes>
+void CRO<Genes>::determineFitnessValue() 
 {	
-	// Determine Fitness for corals in reef
-	for (int i = 0; i < reefSize_; i++) 
+	// Every tile decodes its corals and its larvae in water as one batch.
+	// Only chromosomes changed by a genetic operator need decoding.
+	for (ReefTile& tile : tiles_)
 	{
-		int coralNumber = 0;
-		for(auto& coral : reef_[i])
+		tile.evaluatedCorals.clear();
+	}
+	for (int i = 0; i < occupancy_.occupiedCount(); i++)
+	{
+		const int cell = occupancy_.occupiedCell(i);
+		if (!reef_[cell].fitnessValid_)
 		{
-			if (!coral) 
-			{
-				coralNumber++;
-				continue;
-			}
-			// calculate and set maximum completion time
-			int maxCompletionTime = 0;
-			// calculate and set total equipment load
-			int totalEquipmentLoad = 0;
-
-			std::map<int, int> machinesRuntime; // <machineId, machineLoad>
-			std::map<int, int> jobRuntime;		// <jobId, jobCurrentTime>
-			std::vector<int> occurrenceVector(*max_element(coral->processes_.begin(), coral->processes_.end()) + 1, 0);
-
-			for(int gene = 0; gene < numberOfProcesses_; gene++)
-			{
-				const int jobIndex = coral->processes_[gene] - 1;
-				occurrenceVector[jobIndex]++;
-				const int processIndex = occurrenceVector[jobIndex] - 1;
-				const int machineIndex = coral->machines_[gene] -1;
-
-				// Get process duration for the machine
-				int currentWorkpieceTime = jobs_[jobIndex].processes[processIndex].machineDurations[machineIndex];
-
-				auto jobTime = jobRuntime.find(jobIndex);
-				if (jobTime == jobRuntime.end()) 
-				{
-					jobRuntime[jobIndex] = 0;
-				}
-
-				// seaching if the corresponding machine is already running
-				auto machineTime = machinesRuntime.find(machineIndex);
-				if (machineTime != machinesRuntime.end())
-				{
-					if (jobRuntime[jobIndex] > machinesRuntime[machineIndex]) 
-					{
-						jobRuntime[jobIndex] += currentWorkpieceTime;
-						machinesRuntime[machineIndex] = jobRuntime[jobIndex];
-					}
-					else 
-					{
-						machinesRuntime[machineIndex] += currentWorkpieceTime;
-						jobRuntime[jobIndex] = machinesRuntime[machineIndex];
-					}
-				}
-				else
-				{
-					jobRuntime[jobIndex] += currentWorkpieceTime;
-					machinesRuntime.insert({machineIndex, jobRuntime[jobIndex]});
-				}
-			}
-			for(auto it : machinesRuntime)
-			{
-				if (it.second > maxCompletionTime)
-				{
-					maxCompletionTime = it.second;
-				}
-				totalEquipmentLoad+= it.second;
-			}
-			reef_[i][coralNumber]->maxCompletionTime_ = maxCompletionTime;
-			reef_[i][coralNumber]->totalEquipmentLoad_ = totalEquipmentLoad;
-			coralNumber++;
+			tileOf(cell).evaluatedCorals.push_back(&reef_[cell]);
 		}
 	}
 
-	// Determine Fitness for larvae in water
-	for (int i = 0; i < waterLarvae_.size(); i++) 
+	threadPool_.parallelFor(static_cast<int>(tiles_.size()), 1, [&](int begin, int end, int threadIndex)
 	{
-		// calculate and set maximum completion time
-		int maxCompletionTime = 0;
-		// calculate and set total equipment load
-		int totalEquipmentLoad = 0;
-
-		std::map<int, int> machinesRuntime; // <machineId, machineLoad>
-		std::map<int, int> jobRuntime;		// <jobId, jobCurrentTime>
-		std::vector<int> occurrenceVector(*max_element(waterLarvae_[i]->processes_.begin(), waterLarvae_[i]->processes_.end()) + 1, 0);
-
-		for(int gene = 0; gene < numberOfProcesses_; gene++)
+		for (int t = begin; t < end; t++)
 		{
-			const int jobIndex = waterLarvae_[i]->processes_[gene] - 1;
-			occurrenceVector[jobIndex]++;
-			const int processIndex = occurrenceVector[jobIndex] - 1;
-			const int machineIndex = waterLarvae_[i]->machines_[gene] -1;
-
-			// Get process duration for the machine
-			int currentWorkpieceTime = jobs_[jobIndex].processes[processIndex].machineDurations[machineIndex];
-
-			auto jobTime = jobRuntime.find(jobIndex);
-			if (jobTime == jobRuntime.end()) 
+			ReefTile& tile = tiles_[t];
+			for (int i = 0; i < tile.larvae.size(); i++) 
 			{
-				jobRuntime[jobIndex] = 0;
+				if (!tile.larvae[i].fitnessValid_) 
+				{
+					tile.evaluatedCorals.push_back(&tile.larvae[i]);
+				}
 			}
 
-			// seaching if the corresponding machine is already running
-			auto machineTime = machinesRuntime.find(machineIndex);
-			if (machineTime != machinesRuntime.end())
+			tile.evaluationBatch.clear();
+			for (Coral<Genes>* coral : tile.evaluatedCorals) 
 			{
-				if (jobRuntime[jobIndex] > machinesRuntime[machineIndex]) 
-				{
-					jobRuntime[jobIndex] += currentWorkpieceTime;
-					machinesRuntime[machineIndex] = jobRuntime[jobIndex];
-				}
-				else 
-				{
-					machinesRuntime[machineIndex] += currentWorkpieceTime;
-					jobRuntime[jobIndex] = machinesRuntime[machineIndex];
-				}
+				tile.evaluationBatch.push_back({coral->processes_, coral->machines_, coral->checkpoints_.holdsState() ? &coral->checkpoints_ : nullptr});
 			}
-			else
+			tile.evaluationResults.resize(tile.evaluationBatch.size());
+
+			decoders_[threadIndex].evaluateAll(tile.evaluationBatch.data(), static_cast<int>(tile.evaluationBatch.size()), tile.evaluationResults.data());
+
+			for (std::size_t i = 0; i < tile.evaluatedCorals.size(); i++) 
 			{
-				jobRuntime[jobIndex] += currentWorkpieceTime;
-				machinesRuntime.insert({machineIndex, jobRuntime[jobIndex]});
+				tile.evaluatedCorals[i]->maxCompletionTime_ = tile.evaluationResults[i].maxCompletionTime;
+				tile.evaluatedCorals[i]->totalEquipmentLoad_ = tile.evaluationResults[i].totalEquipmentLoad;
+				tile.evaluatedCorals[i]->fitnessValid_ = true;
 			}
 		}
-		for(auto it : machinesRuntime)
+	});
+
+	// Offered in tile order, after the parallel part, so the archive sees the same sequence every run
+	for (const ReefTile& tile : tiles_)
+	{
+		for (const Coral<Genes>* coral : tile.evaluatedCorals)
 		{
-			if (it.second > maxCompletionTime)
-			{
-				maxCompletionTime = it.second;
-			}
-			totalEquipmentLoad+= it.second;
+			archive_->offer(*coral);
 		}
-		waterLarvae_[i]->maxCompletionTime_ = maxCompletionTime;
-		waterLarvae_[i]->totalEquipmentLoad_ = totalEquipmentLoad;
 	}
 }
 
-void CRO::calculateDominationCounts() 
+template <typename Genes>
+void CRO<Genes>::calculateDominationCounts() 
 {
-	// Cleanup old domination counts
-	for (int i = 0; i < reefSize_; i++) 
+	dominanceOrder_.clear();
+	for (int i = 0; i < occupancy_.occupiedCount(); i++) 
 	{
-		for(auto& coral : reef_[i])
-		{
-			if (!coral) 
-			{
-				continue;
-			}
-			coral->dominationCount_ = 0;
-		}
+		Coral<Genes>& coral = reef_[occupancy_.occupiedCell(i)];
+		coral.dominationCount_ = 0;
+		dominanceOrder_.push_back(&coral);
+	}
+
+	std::sort(dominanceOrder_.begin(), dominanceOrder_.end(), [](const Coral<Genes>* a, const Coral<Genes>* b)
+	{
+		if (a->maxCompletionTime_ == b->maxCompletionTime_)
+			return a->totalEquipmentLoad_ < b->totalEquipmentLoad_;
+		return a->maxCompletionTime_ < b->maxCompletionTime_;
+	});
+
+	// Compress loads to dense ranks for the tree
+	equipmentLoads_.clear();
+	for (const Coral<Genes>* coral : dominanceOrder_) 
+	{
+		equipmentLoads_.push_back(coral->totalEquipmentLoad_);
 	}
+	std::sort(equipmentLoads_.begin(), equipmentLoads_.end());
+	equipmentLoads_.erase(std::unique(equipmentLoads_.begin(), equipmentLoads_.end()), equipmentLoads_.end());
+	loadTree_.reset(static_cast<int>(equipmentLoads_.size()));
+
+	auto loadRank = [this](int load)
+	{
+		return static_cast<int>(std::lower_bound(equipmentLoads_.begin(), equipmentLoads_.end(), load) - equipmentLoads_.begin());
+	};
 
-    for (int row1 = 0; row1 < reefSize_; ++row1) 
+	// Corals sharing a completion time are inserted together, so the tree then holds every coral
+	// that is no worse in both objectives. Identical objective pairs do not dominate each other.
+	std::size_t groupBegin = 0;
+	while (groupBegin < dominanceOrder_.size()) 
 	{
-        for (int col1 = 0; col1 < reefSize_; ++col1) 
+		const int completionTime = dominanceOrder_[groupBegin]->maxCompletionTime_;
+		std::size_t groupEnd = groupBegin;
+		while (groupEnd < dominanceOrder_.size() && dominanceOrder_[groupEnd]->maxCompletionTime_ == completionTime) 
+		{
+			loadTree_.add(loadRank(dominanceOrder_[groupEnd]->totalEquipmentLoad_), 1);
+			groupEnd++;
+		}
+
+		std::size_t runBegin = groupBegin;
+		while (runBegin < groupEnd) 
 		{
-            if (!reef_[row1][col1]) 
+			const int load = dominanceOrder_[runBegin]->totalEquipmentLoad_;
+			std::size_t runEnd = runBegin;
+			while (runEnd < groupEnd && dominanceOrder_[runEnd]->totalEquipmentLoad_ == load) 
 			{
-				continue;  // Skip if spot not populated
+				runEnd++;
 			}
-            // Starting (row2, col2) from (row1, col1) to avoid duplicate pairs
-            for (int row2 = row1; row2 < reefSize_; ++row2) 
+
+			const int dominators = loadTree_.prefixSum(loadRank(load)) - static_cast<int>(runEnd - runBegin);
+			for (std::size_t i = runBegin; i < runEnd; i++) 
 			{
-                for (int col2 = 0; col2 < reefSize_; ++col2) 
-				{
-                    // Skip duplicate elements, self-pairs, and empty slots
-                    if ((row2 == row1 && col2 <= col1) || !reef_[row2][col2]) continue;
-					
-					// check if coral 1 dominates coral 2
-					if (reef_[row1][col1]->dominates(reef_[row2][col2]))
-					{
-						reef_[row2][col2]->dominationCount_+=1;
-					}
-
-					// check if coral 2 dominates coral 1
-					if (reef_[row2][col2]->dominates(reef_[row1][col1]))
-					{
-						reef_[row1][col1]->dominationCount_+=1;
-					}
-                }
-            }
-        }
-    }
+				dominanceOrder_[i]->dominationCount_ += dominators;
+			}
+			runBegin = runEnd;
+		}
+
+		groupBegin = groupEnd;
+	}
 }
 
-void CRO::larvaSettling(int allowedLarvaeInReef) 
+template <typename Genes>
+void CRO<Genes>::larvaSettling() 
 {
-	std::random_device rd;
-	// Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count();
-	std::mt19937 gen(seed);
-
-	int numberOfRetries = 3;
-	for (auto i = 0; i < allowedLarvaeInReef; i++) 
+	// Cell states mirror the reef, so a larva is compared with an occupant without reading its genes
+	threadPool_.parallelFor(static_cast<int>(tiles_.size()), 1, [&](int begin, int end, int /*threadIndex*/)
 	{
-		if (numberOfRetries == 0) 
+		for (int t = begin; t < end; t++)
 		{
-			numberOfRetries = 3;
-			continue;
+			settleTile(tiles_[t]);
 		}
+	});
 
-		int row = gen() % reefSize_;
-		int col = gen() % reefSize_;
-
-		if (!reef_[row][col])
-		{
-			reef_[row][col] = waterLarvae_[i];
-			currentPopulation_.push_back(std::make_pair(row, col));
-			numberOfRetries = 3;
-		} 
-		else if (waterLarvae_[i]->dominates(reef_[row][col])) 
-		{
-			reef_[row][col] = waterLarvae_[i];
-		} 
-		else 
+	// Removing the larvae from water
+	for (ReefTile& tile : tiles_)
+	{
+		for (int cell : tile.settledCells)
 		{
-			i--; numberOfRetries--;
+			occupancy_.occupy(cell);
 		}
+		tile.larvae.clear();
 	}
-
-	// Removing the larvae from water
-	waterLarvae_.clear();
 }
 
-void CRO::extremeDepredation() {
-	int maxDuplicatesAllowed = 3;
-	
-	std::vector<std::pair<int,int>> objectives;
-	for (int row = 0; row < reefSize_; row++) 
-	{
-        for (int col = 0; col < reefSize_; col++) 
+template <typename Genes>
+void CRO<Genes>::settleTile(ReefTile& tile)
+{
+	// A uniformly probed cell is free with probability free / total, and is then
+	// uniform among the free cells, so draw from the matching list directly. The
+	// lists only change once every tile has settled, so all tiles draw from the
+	// reef as it was when settlement began.
+	const int freeCount = occupancy_.freeCount();
+	const int occupiedCount = occupancy_.occupiedCount();
+	std::uniform_int_distribution<int> probe(0, freeCount + occupiedCount - 1);
+	std::uniform_int_distribution<int> freeIndex(0, std::max(freeCount - 1, 0));
+	std::uniform_int_distribution<int> occupiedIndex(0, std::max(occupiedCount - 1, 0));
+
+	tile.settledCells.clear();
+	const int larvaCount = tile.larvae.size();
+	for (int i = 0; i < larvaCount; i++) 
+	{
+		const Coral<Genes>& larva = tile.larvae[i];
+		const std::uint64_t larvaKey = objectiveKey(larva);
+
+		for (int attempt = 0; attempt < settlementAttempts_; attempt++)
 		{
-			if (reef_[row][col]) 
+			// A free cell is always taken, an occupied one only from a coral the larva dominates.
+			// Claiming the cell is a compare-and-swap; losing it to a larva of another tile, or an
+			// earlier one of this tile, is a failed attempt.
+			const bool probeIsFree = probe(tile.random) < freeCount;
+			const int cell = probeIsFree ? occupancy_.freeCell(freeIndex(tile.random)) : occupancy_.occupiedCell(occupiedIndex(tile.random));
+			std::uint64_t occupant = cellStates_[cell].load(std::memory_order_relaxed);
+			if (occupant == settlingCell || (occupant != emptyCell && !keyDominates(larvaKey, occupant)))
 			{
-				objectives.push_back(std::make_pair(reef_[row][col]->maxCompletionTime_, reef_[row][col]->totalEquipmentLoad_));
+				continue;
+			}
+			if (!cellStates_[cell].compare_exchange_strong(occupant, settlingCell, std::memory_order_acquire))
+			{
+				continue;
 			}
-        }
-    }
 
-	for (int row = 0; row < reefSize_; row++) 
-	{
-        for (int col = 0; col < reefSize_; col++) 
-		{
-			if (reef_[row][col]) 
+			// The copy leaves the cell without the larva's decoder state
+			reef_[cell].copyFrom(larva);
+			if (occupant == emptyCell)
 			{
-				int completionTime = reef_[row][col]->maxCompletionTime_;
-				int equipmentLoad = reef_[row][col]->totalEquipmentLoad_;
-				int count = std::count_if(objectives.begin(), objectives.end(),[&](const std::pair<int, int> pair) 
-				{
-					return (pair.first == completionTime && pair.second == equipmentLoad);
-				});
-
-				if(count > maxDuplicatesAllowed) {
-					reef_[row][col] = nullptr;
-					auto it1 = std::find(
-						objectives.begin(), 
-						objectives.end(), 
-						std::make_pair(completionTime, equipmentLoad));
-					if (it1 != objectives.end()) 
-					{
-						objectives.erase(it1);
-					}
-
-					auto it2 = std::find(
-						currentPopulation_.begin(), 
-						currentPopulation_.end(), 
-						std::make_pair(row, col));
-					if (it2 != currentPopulation_.end()) 
-					{
-						currentPopulation_.erase(it2);
-					}
-				}
+				tile.settledCells.push_back(cell);
 			}
-        }
-    }
+			cellStates_[cell].store(larvaKey, std::memory_order_release);
+			break;
+		}
+	}
 }
 
-void CRO::asexualReproduction() 
-{
-	for (int i = 0; i < reefSize_; i++) 
+template <typename Genes>
+void CRO<Genes>::extremeDepredation() {
+	int maxDuplicatesAllowed = 3;
+
+	// Number of cells holding each objective pair
+	objectiveCounts_.clear();
+	for (int i = 0; i < occupancy_.occupiedCount(); i++) 
 	{
-		for(auto coral : reef_[i])
-		{
-			if (!coral) 
-			{
-				continue;
-			}
-			waterLarvae_.push_back(coral);
+		objectiveCounts_[objectiveKey(reef_[occupancy_.occupiedCell(i)])]++;
+	}
+
+	// Cells of an over-represented pair are cleared until only the allowed duplicates remain.
+	// Walked from the back: a vacated cell's slot is taken by the last cell, already visited.
+	for (int i = occupancy_.occupiedCount() - 1; i >= 0; i--) 
+	{
+		const int cell = occupancy_.occupiedCell(i);
+		int& count = objectiveCounts_[objectiveKey(reef_[cell])];
+		if(count > maxDuplicatesAllowed) {
+			count--;
+			vacateCell(cell);
 		}
 	}
+}
 
-	// Sort water larva by domination count
-	std::sort(waterLarvae_.begin(), waterLarvae_.end(),[](const CoralPtr &a, const CoralPtr &b) 
+template <typename Genes>
+void CRO<Genes>::asexualReproduction() 
+{
+	buddingOrder_.clear();
+	for (int i = 0; i < occupancy_.occupiedCount(); i++) 
 	{
-    	return a->dominationCount_ < b->dominationCount_;
+		buddingOrder_.push_back(occupancy_.occupiedCell(i));
+	}
+
+	// Sort corals by domination count
+	std::sort(buddingOrder_.begin(), buddingOrder_.end(),[this](int a, int b) 
+	{
+    	return reef_[a].dominationCount_ < reef_[b].dominationCount_;
 	});
 
-	int buddingCount = (waterLarvae_.size() * buddingFactor_) / 100;
+	int buddingCount = (buddingOrder_.size() * buddingFactor_) / 100;
+
+	// The buds are copied out first, settling may overwrite the cells they come from.
+	// They are dealt to the tiles in turn.
+	for (int i = 0; i < buddingCount; i++) 
+	{
+		CoralPool<Genes>& larvae = tiles_[i % tiles_.size()].larvae;
+		larvae.resize(larvae.size() + 1);
+		larvae[larvae.size() - 1].copyFrom(reef_[buddingOrder_[i]]);
+	}
 
-	larvaSettling(buddingCount);
+	larvaSettling();
 }
 
-void CRO::depredation() 
+template <typename Genes>
+void CRO<Genes>::depredation() 
 {
-	std::vector<std::pair<std::pair<int,int>,int>> coralDominationCounts;
-	for (int row = 0; row < reefSize_; row++) 
+	std::vector<std::pair<int,int>> coralDominationCounts;
+	for (int i = 0; i < occupancy_.occupiedCount(); i++) 
 	{
-        for (int col = 0; col < reefSize_; col++) 
-		{
-			if (reef_[row][col]) 
-			{
-				coralDominationCounts.push_back(std::make_pair(std::make_pair(row, col), reef_[row][col]->dominationCount_));
-			}
-        }
-    }
+		const int cell = occupancy_.occupiedCell(i);
+		coralDominationCounts.push_back(std::make_pair(cell, reef_[cell].dominationCount_));
+	}
 	// Sort corals by domination count
 	std::sort(coralDominationCounts.begin(), coralDominationCounts.end(),[](const auto &a, const auto &b) 
 	{
@@ -549,324 +636,177 @@ void CRO::depredation()
 
 	for (int i = 0; i < depredationCount; i++) 
 	{
-		reef_[coralDominationCounts[i].first.first][coralDominationCounts[i].first.second] = nullptr;
-		auto it = std::find(
-			currentPopulation_.begin(), 
-			currentPopulation_.end(), 
-			std::make_pair(coralDominationCounts[i].first.first, coralDominationCounts[i].first.second));
-		if (it != currentPopulation_.end()) 
-		{
-			currentPopulation_.erase(it);
-		}
+		vacateCell(coralDominationCounts[i].first);
 	}
 }
 
-void CRO::cleanupOldValues()
+template <typename Genes>
+std::uint64_t CRO<Genes>::objectiveKey(const Coral<Genes>& coral) 
 {
-	for (int i = 0; i < reefSize_; i++) 
-	{
-		for(auto& coral : reef_[i])
-		{
-			if (!coral) 
-			{
-				continue;
-			}
-			coral->maxCompletionTime_ = 0;
-			coral->totalEquipmentLoad_ = 0;
-			coral->dominationCount_ = 0;
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(coral.maxCompletionTime_)) << 32) |
+		   static_cast<std::uint32_t>(coral.totalEquipmentLoad_);
+}
 
-			coral->frontLevel_ = 0;
-			coral->crowdingDistance_ = 0.0;
-		}
+template <typename Genes>
+bool CRO<Genes>::keyDominates(std::uint64_t key, std::uint64_t other)
+{
+	const std::uint32_t completionTime = static_cast<std::uint32_t>(key >> 32), otherCompletionTime = static_cast<std::uint32_t>(other >> 32);
+	const std::uint32_t load = static_cast<std::uint32_t>(key), otherLoad = static_cast<std::uint32_t>(other);
+	return completionTime <= otherCompletionTime && load <= otherLoad && key != other;
+}
+
+template <typename Genes>
+void CRO<Genes>::cleanupOldValues()
+{
+	for (int i = 0; i < occupancy_.occupiedCount(); i++) 
+	{
+		// Objective values stay cached on the chromosome
+		reef_[occupancy_.occupiedCell(i)].dominationCount_ = 0;
 	}
 }
 
-void CRO::outputOptimalSolution() 
+template <typename Genes>
+void CRO<Genes>::outputOptimalSolution() 
 {
 	determineFitnessValue();
 	calculateDominationCounts();
 
-	std::vector<CoralPtr> solutions;
-	for (int i = 0; i < reefSize_; i++) 
+	std::vector<const Coral<Genes>*> solutions;
+	for (int i = 0; i < occupancy_.occupiedCount(); i++) 
 	{
-		for(auto& coral : reef_[i])
-		{
-			if (!coral) {
-				continue;
-			}
-			solutions.push_back(coral);
-		}
+		solutions.push_back(&reef_[occupancy_.occupiedCell(i)]);
 	}
 
 	// Sort corals asc by domination count
-	std::sort(solutions.begin(), solutions.end(),[](const CoralPtr &a, const CoralPtr &b) 
+	std::sort(solutions.begin(), solutions.end(),[](const Coral<Genes>* a, const Coral<Genes>* b) 
 	{
     	return a->dominationCount_ < b->dominationCount_;
 	});
 
 	std::cout << solutions[solutions.size()-1]->getGenesAsString() << ";";
-	std::cout << solutions[0]->getGenesAsString();
+
+	// The best solution is the archived one with the lowest makespan; it may
+	// have been depredated generations ago
+	CoralPool<Genes> front(instance_.numberOfOperations());
+	archive_->copyMembers(front);
+	std::cout << front[0].getGenesAsString();
+
+	std::cerr << "CRO archive: " << front.size() << " members, makespan " << front[0].maxCompletionTime_ << "-" << front[front.size() - 1].maxCompletionTime_
+			  << ", load " << front[front.size() - 1].totalEquipmentLoad_ << "-" << front[0].totalEquipmentLoad_ << std::endl;
 }
 
-std::vector<Job> CRO::importDefaultSample(std::string fileName)
+template <typename Genes>
+CheckpointHeader CRO<Genes>::checkpointHeader(int generation) const
 {
-	std::vector<Job> jobs = std::vector<Job>(numberOfJobs_);
-
-	std::ifstream file(fileName);
-	std::string content;
+	CheckpointHeader header;
+	header.solver = "CRO";
+	header.seed = options_.seed;
+	header.geneBytes = sizeof(typename Genes::JobGene) + sizeof(typename Genes::MachineGene);
+	header.numberOfGenes = instance_.numberOfOperations();
+	header.populationSize = reefSize_;
+	header.generations = generations_;
+	header.generation = generation;
+	return header;
+}
 
-	if (!file.is_open()) 
-	{
-        content = "1,1:12,5,18,10,16,23,18,12,21,13;1,2:15,12,5,16,7,18,21,17,16,9;1,3:17,4,12,11,9,14,11,10,25,10;2,1:19,14,5,17,16,13,10,15,14,6;2,2:18,14,24,11,16,19,20,9,22,7;2,3:13,16,10,15,18,16,17,5,15,16;2,4:8,7,12,6,5,10,22,8,8,17;3,1:16,13,18,6,14,7,20,12,19,5;3,2:11,10,9,16,11,8,5,12,10,5;4,1:21,17,21,16,20,5,18,8,19,17;4,2:5,24,12,20,17,18,20,22,21,14;4,3:6,7,5,5,7,6,16,9,17,10;5,1:23,14,12,5,15,11,13,14,5,16;5,2:15,5,22,12,16,8,13,18,8,13;5,3:12,10,11,14,15,25,16,13,15,15;6,1:5,15,6,17,20,16,14,10,5,19;6,2:14,13,12,5,15,7,11,14,17,13;7,1:18,21,15,12,9,24,7,5,20,7;7,2:17,14,15,17,19,20,15,12,16,15;7,3:8,10,9,8,7,12,14,7,8,9;7,4:15,20,18,23,5,16,10,16,6,21;7,5:12,25,16,8,15,9,18,17,20,5;7,6:10,8,7,7,7,8,9,17,6,8;8,1:17,20,8,23,19,19,11,15,16,5;8,2:5,18,15,20,16,22,19,17,13,14;8,3:24,7,26,24,25,24,9,18,10,20;8,4:5,22,16,18,13,7,19,8,20,21;9,1:5,7,7,11,8,11,10,23,8,18;9,2:24,25,7,22,12,18,5,20,17,21;9,3:15,9,13,13,14,10,12,11,16,10;10,1:20,21,18,11,19,18,17,8,22,19;10,2:15,14,8,15,10,16,13,15,16,12;10,3:11,15,8,12,10,13,23,8,9,9";
-    } 
-	else 
+template <typename Genes>
+void CRO<Genes>::saveCheckpoint(int generation)
+{
+	// What a generation leaves to the next: the random streams, the cell lists
+	// and the corals of the occupied cells, the archive and the stagnation state.
+	// Decoder checkpoints are left out, a resumed coral is decoded in full once.
+	CheckpointWriter out(options_.checkpointPath);
+	out.writeHeader(checkpointHeader(generation));
+	out.write(random_);
+	out.write(static_cast<int>(tiles_.size()));
+	for (const ReefTile& tile : tiles_)
+	{
+		out.write(tile.random);
+	}
+	occupancy_.save(out);
+	for (int i = 0; i < occupancy_.occupiedCount(); i++)
 	{
-		if (fileName.compare("dataset.txt") == 0) {
-			content = std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-		} else {
-			std::stringstream result;
-
-			int number_total_jobs, number_total_machines, number_max_operations;
-			std::string line;
-			std::getline(file, line);
-			std::istringstream headerStream(line);
-			headerStream >> number_total_jobs >> number_total_machines >> number_max_operations;
-
-			// Set Job Id to 1 to initiate dataset load
-			int currentJob = 1;
-
-			while (std::getline(file, line)) {
-				if (currentJob > number_total_jobs) {
-					break;
-				}
-
-
-				std::istringstream lineStream(line);
-				int number_operations;
-				lineStream >> number_operations;
-
-				for (int id_operation = 0; id_operation < number_operations; ++id_operation) {
-					result << currentJob << "," << id_operation+1 << ":";
-					int machinesNumber;
-					lineStream >> machinesNumber;
-					std::map<int,int> machinesMap;
-					for (int i = 1; i <= number_total_machines; i++) {
-						machinesMap.insert(std::make_pair(i,100));
-					}
-					for (int i = 0; i < machinesNumber; i++) {
-						int machine, time;
-						lineStream >> machine >> time;
-						machinesMap[machine] = time;
-					}
-
-					for (int i = 1; i <= number_total_machines; i++) {
-						if (i == number_total_machines) {
-							result << machinesMap[i] << ";";
-							break;
-						}
-						result << machinesMap[i] << ",";
-					}
-				}
-				currentJob++;
-			}
-
-			content = result.str();
-		}
+		out.writeChromosome(reef_[occupancy_.occupiedCell(i)]);
 	}
+	archive_->save(out);
+	stopCondition_.save(out);
 
-	size_t firstPeriodPos = content.find('.');
-    std::string jobsStr = content.substr(0, firstPeriodPos);
-    std::istringstream ssJobs(jobsStr);
-    std::string tokenJobs;
-
-	int currentJobIndex = 0;
-    while (std::getline(ssJobs, tokenJobs, ';')) 
+	if (!out.commit())
 	{
-        size_t colonPos = tokenJobs.find(':');
-        std::string operation = tokenJobs.substr(0, colonPos);
-        std::string durations = tokenJobs.substr(colonPos + 1);
-
-        std::istringstream durationsStream(durations);
-        std::vector<std::string> durationsArray(std::istream_iterator<std::string>{durationsStream}, 
-                                                std::istream_iterator<std::string>());
-
-		size_t colonPos2 = operation.find(',');
-        std::string jobId = operation.substr(0, colonPos2);
-
-		std::stringstream ssDurations(durations);
-		std::string tokenDurations;
-
-		std::map<int, int> processDurations;
-		int machineIndex = 0;
-		while (std::getline(ssDurations, tokenDurations, ',')) 
-		{
-			processDurations[machineIndex] = std::stoi(tokenDurations);
-			machineIndex++;
-		}
-
-		if (std::stoi(jobId) != (currentJobIndex+1)) 
-		{
-			currentJobIndex++;
-			
-		}
-		jobs[currentJobIndex].processes.push_back(Job::Process(processDurations));
-    }
-
-	file.close();
-	
-	return jobs;
+		std::cerr << "CRO could not write checkpoint " << options_.checkpointPath << std::endl;
+	}
 }
 
-std::vector<Job> CRO::generateJobs(int numberOfJobs, int numberOfMachines, int numberOfProcesses) 
+template <typename Genes>
+bool CRO<Genes>::restoreCheckpoint(int& generation)
 {
-	std::vector<Job> jobs;
-
-	std::random_device rd;
-	// Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count() ^
-                       static_cast<std::size_t>(numberOfJobs);
-	std::mt19937 gen(seed);
-	std::uniform_int_distribution<> dis(0, numberOfJobs - 1);
-
-	for (int i = 0; i < numberOfJobs; i++) 
+	CheckpointReader in(options_.resumePath);
+	CheckpointHeader header;
+	if (!in.readHeader(header))
 	{
-		std::vector<Job::Process> jobProcesses;
-
-		std::map<int, int> processDurations;
-
-		for (int machineIndex = 0; machineIndex < numberOfMachines; ++machineIndex) 
-		{
-			processDurations[machineIndex] = std::max(static_cast<int>(gen() % maxDuration_) + 1, 1); // Random duration for each machine
-		}
-		jobProcesses.push_back(Job::Process(processDurations));
-		jobs.push_back(Job(jobProcesses));
-
-		numberOfProcesses--;
+		std::cerr << "CRO cannot read checkpoint " << options_.resumePath << std::endl;
+		return false;
 	}
+	std::string mismatch = header.mismatch(checkpointHeader(header.generation));
 
-	while (numberOfProcesses > 0) 
+	int numberOfTiles = 0;
+	in.read(random_);
+	in.read(numberOfTiles);
+	if (mismatch.empty() && numberOfTiles != static_cast<int>(tiles_.size()))
 	{
-		int randomJob = dis(gen);
-
-		std::map<int, int> processDurations;
-
-		for (int machineIndex = 0; machineIndex < numberOfMachines; ++machineIndex) 
-		{
-			processDurations[machineIndex] = std::max(static_cast<int>(gen() % maxDuration_) + 1, 1); // Random duration for each machine
-		}
-
-		jobs[randomJob].processes.push_back(Job::Process(processDurations));
-
-		numberOfProcesses--;
+		mismatch = "it was written with " + std::to_string(numberOfTiles) + " reef tiles";
+	}
+	if (!mismatch.empty())
+	{
+		std::cerr << "CRO cannot resume from " << options_.resumePath << ": " << mismatch << std::endl;
+		return false;
+	}
+	for (ReefTile& tile : tiles_)
+	{
+		in.read(tile.random);
 	}
 
-	return jobs;
-}
-
-void CRO::splitJobs(std::vector<int>& firstGroup, std::vector<int>& secondGroup) 
-{
-	// Original vector of integers -> testing
-	std::vector<int> originalVector(jobs_.size());
-	std::iota(originalVector.begin(), originalVector.end(), 1);
-
-	// Random number generator
-	std::random_device rd;
-	std::mt19937 gen(rd());
-
-	// Ensure that each resulting vector has at least a third of the original size
-	int minVectorSize = originalVector.size() / 3;
-
-	// Generate random sizes for the two new vectors
-	std::uniform_int_distribution<> distribution(minVectorSize, originalVector.size() - minVectorSize);
-	int firstVectorSize = distribution(gen);
-	int secondVectorSize = originalVector.size() - firstVectorSize;
-
-	// Shuffle the original vector to make the splitting random
-	std::shuffle(originalVector.begin(), originalVector.end(), gen);
-
-	// Create the two new vectors and copy elements
-	std::vector<int> firstVector(originalVector.begin(), originalVector.begin() + firstVectorSize);
-	std::vector<int> secondVector(originalVector.begin() + firstVectorSize, originalVector.end());
-
-	firstGroup = firstVector;
-	secondGroup = secondVector;
-}
-
-void CRO::printJobs(std::vector<Job> jobs)
-{
-	for (int i = 0; i < jobs.size(); ++i) 
+	const bool occupancyRestored = occupancy_.restore(in, reef_.size());
+	for (int i = 0; occupancyRestored && i < occupancy_.occupiedCount(); i++)
 	{
-		std::cout << "Job " << i + 1 << ":\n";
-		for (int j = 0; j < jobs[i].processes.size(); ++j) 
-		{
-			std::cout << "  Process " << j + 1 << ":\n";
-			for (const auto& durationPair : jobs[i].processes[j].machineDurations) 
-			{
-				std::cout << "    Machine " << durationPair.first << ": " << durationPair.second << " minutes\n";
-			}
-		}
-		std::cout << std::endl;
+		const int cell = occupancy_.occupiedCell(i);
+		Coral<Genes>& coral = reef_[cell];
+		in.readChromosome(coral);
+		coral.checkpoints_.invalidateFrom(0);
+		coral.dominationCount_ = 0;
+		cellStates_[cell].store(objectiveKey(coral), std::memory_order_relaxed);
 	}
-}
 
-void CRO::outputJobs(std::vector<Job> jobs)
-{
-	for (int i = 0; i < jobs.size(); ++i) 
+	const bool archiveRestored = occupancyRestored && archive_->restore(in);
+	stopCondition_.restore(in);
+	if (!archiveRestored || !in.good())
 	{
-		for (int j = 0; j < jobs[i].processes.size(); ++j) 
-		{
-			std::cout << i + 1 << "," << j + 1 << ":";
-			for (const auto& durationPair : jobs[i].processes[j].machineDurations) 
-			{
-				if (std::addressof(durationPair) == std::addressof(*(std::prev(jobs[i].processes[j].machineDurations.end())))) 
-				{
-					if (i + 1 != jobs.size()) 
-					{
-						std::cout << durationPair.second << ";";
-					}
-					else 
-					{
-						if(j + 1 == jobs[i].processes.size())
-							std::cout << durationPair.second << ".";
-						else 
-						{
-							std::cout << durationPair.second << ";";
-						}
-					}
-				}
-				else 
-				{
-					std::cout << durationPair.second << ",";
-				}
-			}
-		}
+		std::cerr << "CRO checkpoint " << options_.resumePath << " is damaged" << std::endl;
+		return false;
 	}
+
+	generation = header.generation;
+	std::cerr << "CRO resumed after generation " << generation << std::endl;
+	return true;
 }
 
-void CRO::printPopulation() 
+template <typename Genes>
+void CRO<Genes>::printPopulation() 
 {
-	for (int i = 0; i < reefSize_; i++) 
+	for (int i = 0; i < occupancy_.occupiedCount(); i++) 
 	{
-        for (int j = 0; j < reefSize_; j++) 
-		{
-			if (reef_[i][j]) 
-			{
-				std::cout << *reef_[i][j] << std::endl;
-			}
-        }
-    }
+		std::cout << reef_[occupancy_.occupiedCell(i)] << std::endl;
+	}
 }
 
-void CRO::printPopulationGrid() 
+template <typename Genes>
+void CRO<Genes>::printPopulationGrid() 
 {
 	for (int i = 0; i < reefSize_; i++) 
 	{
         for (int j = 0; j < reefSize_; j++) 
 		{
-			if (reef_[i][j]) 
+			if (occupancy_.isOccupied(i * reefSize_ + j)) 
 			{
 				std::cout << "1 ";
 			} else std::cout << "0 ";
@@ -875,6 +815,7 @@ void CRO::printPopulationGrid()
     }
 }
 
+#ifndef JSSP_NO_MAIN
 int main(int argc, char* argv[])
 {
 	bool command_line_args = true;
@@ -883,6 +824,7 @@ int main(int argc, char* argv[])
 	int reefSize;
 	int generations;
 	std::string useDefault;
+	SolverOptions options;
 
 	if (command_line_args) 
 	{
@@ -901,11 +843,17 @@ int main(int argc, char* argv[])
 			
 			// Sample data
 			useDefault = std::string(argv[6]);
+
+			options = SolverOptions::fromCommandLine(CommandLine(argc, argv, 7));
 		}
 		else 
 		{
 			// Print an error message if there are not enough arguments
-			std::cout << "Usage: " << argv[0] << " <numberOfJobs>" << " <numberOfMachines>" << " <numberOfProcesses>" << " <reefSize>" << " <generations>" << " <useDefault>. Only " << argc << " args provided." << std::endl;
+			std::cout << "Usage: " << argv[0] << " <numberOfJobs>" << " <numberOfMachines>" << " <numberOfProcesses>" << " <reefSize>" << " <generations>" << " <useDefault>"
+					  << " [--threads <count>] [--reef-tiles <count>] [--fitness-cache <slots>] [--delta-evaluation 0|1]"
+					  << " [--archive-epsilon <fraction>] [--time-limit-ms <ms>] [--stagnation-window <generations>] [--stagnation-epsilon <fraction>]"
+					  << " [--checkpoint <file>] [--checkpoint-interval <generations>] [--resume <file>]"
+					  << " [--compact-genes 0|1] [--seed <seed>]. Only " << argc << " args provided." << std::endl;
 			return 0;
 		}
 	}
@@ -927,7 +875,33 @@ int main(int argc, char* argv[])
 		std::cin >> generations;
 	}
 
-	std::unique_ptr<CRO> workshop = std::make_unique<CRO>(numberOfJobs, numberOfMachines, numberOfProcesses, reefSize, generations, useDefault);
-	workshop->run();
-	return 0;
-}
\ No newline at end of file
+	const std::string invalidOption = options.invalidOption();
+	if (!invalidOption.empty())
+	{
+		std::cerr << invalidOption << std::endl;
+		return 1;
+	}
+
+	std::vector<Job> jobs = loadJobs(useDefault, numberOfJobs, numberOfMachines, numberOfProcesses, options.seed);
+	ProblemInstance instance(jobs, numberOfMachines);
+
+	// Every operation needs a machine to run on, or no schedule exists
+	const int unschedulable = instance.unschedulableOperation();
+	if (unschedulable != -1)
+	{
+		const int jobIndex = instance.jobOfOperation(unschedulable);
+		std::cerr << "Operation " << jobIndex + 1 << "," << unschedulable - instance.jobOffset(jobIndex) + 1
+				  << " cannot run on any machine." << std::endl;
+		return 1;
+	}
+
+	bool completed = true;
+	withGeneEncoding(instance, options.compactGenes, [&](auto genes)
+	{
+		using Genes = decltype(genes);
+		std::unique_ptr<CRO<Genes>> workshop = std::make_unique<CRO<Genes>>(numberOfJobs, numberOfMachines, numberOfProcesses, reefSize, generations, jobs, options);
+		completed = workshop->run();
+	});
+	return completed ? 0 : 1;
+}
+#endif
@@ -1,45 +1,100 @@
 #pragma once
 #include <vector>
 #include <map>
-#include "Job.h"
+#include <memory>
+#include <atomic>
+#include <unordered_map>
+#include <cstdint>
+#include "../Common/ProblemInstance.h"
+#include "../Common/ScheduleDecoder.h"
+#include "../Common/CrossoverEngine.h"
+#include "../Common/FitnessCache.h"
+#include "../Common/ThreadPool.h"
+#include "../Common/SolverOptions.h"
+#include "../Common/FenwickTree.h"
+#include "../Common/GeneEncoding.h"
+#include "../Common/RandomEngine.h"
+#include "../Common/ParetoArchive.h"
+#include "../Common/ConvergenceLog.h"
+#include "../Common/StopCondition.h"
+#include "../Common/Checkpoint.h"
 #include "Coral.h"
+#include "ReefOccupancy.h"
 
+// Genes is the GeneEncoding the corals are stored in
+template <typename Genes>
 class CRO {
 public:
 	CRO();
-	CRO(int numberOfJobs, int numberOfMachines, int numberOfProcesses, int reefSize, int generations, std::string useDefault);
-	void run();
+	CRO(int numberOfJobs, int numberOfMachines, int numberOfProcesses, int reefSize, int generations, std::vector<Job> jobs, const SolverOptions& options = SolverOptions());
+	// False if the run could not be resumed from options.resumePath
+	bool run();
+
+	// Stepwise use by the hybrid solver, which reports the results itself
+	void prepareCoevolution(std::uint64_t stream);
+	void evolve(int firstGeneration, int lastGeneration);
+	int offerToArchive(ParetoArchive<Genes>& archive);
+	void importFromArchive(const ParetoArchive<Genes>& archive, int count);
+	void setStopCondition(const StopCondition& stopCondition) { stopCondition_ = stopCondition; }
+
 private:
+	// A band of reef rows. Its corals spawn and are evaluated together on one
+	// thread, and its larvae settle anywhere on the reef.
+	struct ReefTile
+	{
+		int firstCell = 0;
+		int endCell = 0;
+		RandomEngine random;
+		CoralPool<Genes> larvae; // larvae in water, refilled every generation
+		std::vector<int> cells; // its occupied cells, shuffled for spawning
+		std::vector<int> settledCells; // free cells its larvae settled in
+		std::vector<Coral<Genes>*> evaluatedCorals;
+		std::vector<ChromosomeRef<Genes>> evaluationBatch;
+		std::vector<Fitness> evaluationResults;
+	};
+
+	void prepareInstance();
+	void prepareReef();
+	ReefTile& tileOf(int cell) { return tiles_[rowTiles_[cell / reefSize_]]; }
+	void vacateCell(int cell);
 	void initializePopulation();
 	void sexualReproduction();
-	void broadcastSpawning(const CoralPtr& parent1, const CoralPtr& parent2);
-	void broodingMutation(const CoralPtr& coral);
+	void broadcastSpawning(ReefTile& tile, CrossoverEngine& crossover, const Coral<Genes>& parent1, const Coral<Genes>& parent2);
+	void broodingMutation(ReefTile& tile, ScheduleDecoder& decoder, const Coral<Genes>& coral);
 	void determineFitnessValue();
 	void calculateDominationCounts();
-	void larvaSettling(int allowedLarvaeInReef);
+	void larvaSettling();
+	void settleTile(ReefTile& tile);
 	void extremeDepredation();
 	void asexualReproduction();
 	void depredation();
 	void cleanupOldValues();
+	static std::uint64_t objectiveKey(const Coral<Genes>& coral);
+	// Dominance between the objective pairs packed by objectiveKey
+	static bool keyDominates(std::uint64_t key, std::uint64_t other);
 	void outputOptimalSolution();
 
+	CheckpointHeader checkpointHeader(int generation) const;
+	void saveCheckpoint(int generation);
+	bool restoreCheckpoint(int& generation);
+
 	// utility methods
-	std::vector<Job> importDefaultSample(std::string fileName = "dataset.txt");
-	std::vector<Job> generateJobs(int numberOfJobs, int numberOfMachines, int numberOfProcesses);
-	void splitJobs(std::vector<int>& firstGroup, std::vector<int>& secondGroup);
 	void printPopulation();
 	void printPopulationGrid();
-	void printJobs(std::vector<Job> jobs);
-	void outputJobs(std::vector<Job> jobs);
 
 
 	int numberOfJobs_, numberOfMachines_;
 	int generations_;
 	int reefSize_;
 	int numberOfProcesses_;
-	std::vector<std::pair<int, int>> currentPopulation_;;
-	std::vector<CoralPtr> waterLarvae_;
-	const int maxDuration_ = 10;
+	ReefOccupancy occupancy_; // cells indexed row * reefSize_ + col
+	std::vector<ReefTile> tiles_;
+	std::vector<int> rowTiles_; // tile of each reef row
+	// Objective key of the coral in each cell, emptyCell for a free one and settlingCell while a larva claims it
+	std::vector<std::atomic<std::uint64_t>> cellStates_;
+	static constexpr std::uint64_t emptyCell = ~std::uint64_t(0);
+	static constexpr std::uint64_t settlingCell = emptyCell - 1;
+	const int settlementAttempts_ = 3; // cells a larva probes before it is lost
 
 	int occupationRate_ = 60; // %
 	int reproductionFactor_ = 70; // %
@@ -48,8 +103,21 @@ private:
 	int depredationProbability_ = 15; // %
 
 	std::vector<Job> jobs_;
-	std::vector<std::vector<CoralPtr>> reef_;
-
-
-	std::string useDefaultSample_ = "0";
+	ProblemInstance instance_;
+	SolverOptions options_;
+	bool deltaEvaluation_ = false; // brooded larvae carry the decoder state in front of their mutation
+	RandomEngine random_;
+	ThreadPool threadPool_;
+	std::vector<ScheduleDecoder> decoders_; // one per pool thread
+	std::vector<CrossoverEngine> crossovers_; // one per pool thread
+	std::unique_ptr<FitnessCache> fitnessCache_;
+	std::unique_ptr<ParetoArchive<Genes>> archive_; // every evaluated chromosome is offered to it
+	std::unique_ptr<ConvergenceLog> convergence_; // only runs that report their own results log one
+	StopCondition stopCondition_; // polled between phases
+	CoralPool<Genes> reef_; // one slot per cell, row-major; occupancy_ tells which hold a coral
+	std::vector<int> buddingOrder_;
+	std::vector<Coral<Genes>*> dominanceOrder_;
+	std::vector<int> equipmentLoads_;
+	FenwickTree loadTree_;
+	std::unordered_map<std::uint64_t, int> objectiveCounts_;
 };
\ No newline at end of file
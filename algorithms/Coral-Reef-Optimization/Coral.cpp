@@ -2,66 +2,52 @@
 #include <random>
 #include <algorithm>
 #include <string>
-#include <ctime>
-#include <chrono>
 
 #include "Coral.h"
-#include "Job.cpp"
+#include "../Common/ProblemInstance.cpp"
 
-Coral::Coral() {}
-
-Coral::Coral(std::shared_ptr<Coral> coral)
+template <typename Genes>
+void Coral<Genes>::copyFrom(const Coral<Genes>& coral)
 {
-	processes_ = coral->processes_;
-	machines_ = coral->machines_;
-
-	maxCompletionTime_ = 0;
-	totalEquipmentLoad_ = 0;
+	std::copy(coral.processes_, coral.processes_ + numberOfGenes_, processes_);
+	std::copy(coral.machines_, coral.machines_ + numberOfGenes_, machines_);
+
+	maxCompletionTime_ = coral.maxCompletionTime_;
+	totalEquipmentLoad_ = coral.totalEquipmentLoad_;
+	fitnessValid_ = coral.fitnessValid_;
+	// A copy holds no decoder state; brooding computes the one its mutation needs
+	checkpoints_.invalidateFrom(0);
+	dominationCount_ = coral.dominationCount_;
 }
 
-Coral::Coral(std::vector<Job> jobs, int numProcesses, int numMachines, int seedEntropy) 
+template <typename Genes>
+void Coral<Genes>::initialize(const ProblemInstance& instance, RandomEngine& gen) 
 {
+	const int numProcesses = instance.numberOfOperations();
+
 	// Iterate through the jobs and their processes
-	for (int jobIndex = 0; jobIndex < jobs.size(); jobIndex++) {
-		for (int processIndex = 0; processIndex < jobs[jobIndex].processes.size(); processIndex++) 
+	int gene = 0;
+	for (int jobIndex = 0; jobIndex < instance.numberOfJobs(); jobIndex++) {
+		for (int processIndex = 0; processIndex < instance.jobLength(jobIndex); processIndex++) 
 		{
-			processes_.push_back(jobIndex + 1);
+			processes_[gene++] = static_cast<JobGene>(jobIndex + 1);
 		}
 	}
 
-	// Shuffle the processes using a random engine
-    std::random_device rd;
-
-    // Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count() ^
-                       static_cast<std::size_t>(seedEntropy);
-
-    // Initialize the random engine with the combined seed
-    std::mt19937 gen(seed);
-
-	std::shuffle(processes_.begin(), processes_.end(), gen);
-	std::vector<int> occurrenceVector(*max_element(processes_.begin(), processes_.end()) + 1, 0);
+	// Shuffle the processes
+	std::shuffle(processes_, processes_ + numberOfGenes_, gen);
+	std::vector<int> occurrenceVector(*std::max_element(processes_, processes_ + numberOfGenes_) + 1, 0);
 
 	for (int i = 0; i < numProcesses; i++) {
 		const int jobIndex = processes_[i] - 1;
 		occurrenceVector[jobIndex]++;
 		const int processIndex = occurrenceVector[jobIndex] - 1;
 
-		auto random = std::rand() % numMachines ;
-		
-		int currentWorkpieceTime = jobs[jobIndex].processes[processIndex].machineDurations[random];
-
-		while(currentWorkpieceTime == 100) {
-			random = std::rand() % numMachines;
-			currentWorkpieceTime = jobs[jobIndex].processes[processIndex].machineDurations[random];
-		}
+		const int operation = instance.operationId(jobIndex, processIndex);
 
-		// std::cout << "CRO_init: " << currentWorkpieceTime << std::endl;
+		const int random = instance.eligibleMachine(operation, gen() % instance.eligibleCount(operation));
 		
-		machines_.push_back(random+1); // Random machine ID
+		machines_[i] = static_cast<MachineGene>(random+1); // Random eligible machine ID
 	}
 
 
@@ -69,22 +55,27 @@ Coral::Coral(std::vector<Job> jobs, int numProcesses, int numMachines, int seedE
 	maxCompletionTime_ = 0;
 	// initialize with 0 total equipment load
 	totalEquipmentLoad_ = 0;
+	fitnessValid_ = false;
+	checkpoints_.invalidateFrom(0);
+	dominationCount_ = 0;
 }
 
-std::string Coral::getGenesAsString()
+template <typename Genes>
+std::string Coral<Genes>::getGenesAsString() const
 {
 	std::stringstream result;
-	std::vector<int> occurrenceVector(*max_element(processes_.begin(), processes_.end()) + 1, 0);
+	std::vector<int> occurrenceVector(*std::max_element(processes_, processes_ + numberOfGenes_) + 1, 0);
 
-	for (auto process : processes_)
+	for (int gene = 0; gene < numberOfGenes_; gene++)
 	{
+		const int process = processes_[gene];
 		occurrenceVector[process]++;
 		result << std::to_string(process) << "," << std::to_string(occurrenceVector[process]) << " ";
 	}
 	
-	for (auto machine : machines_)
+	for (int gene = 0; gene < numberOfGenes_; gene++)
 	{
-		result << std::to_string(machine) << " ";
+		result << std::to_string(machines_[gene]) << " ";
 	}
 
 	result << std::to_string(maxCompletionTime_) << " ";
@@ -96,20 +87,13 @@ std::string Coral::getGenesAsString()
 	return output;
 }
 
-void Coral::mutate(std::vector<Job> jobs,const int& numberOfMachines)
+template <typename Genes>
+int Coral<Genes>::mutate(const ProblemInstance& instance, RandomEngine& gen)
 {
-	std::random_device rd;
-	// Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count() ^ static_cast<std::size_t>(numberOfMachines);
-	std::mt19937 gen(seed);
-
-	int randomMachineIndex = gen() % processes_.size(); // m[3] = 2
+	int randomMachineIndex = gen() % numberOfGenes_; // m[3] = 2
 	int mutatedMachineId = machines_[randomMachineIndex];
 
-	std::vector<int> occurrenceVector(*max_element(processes_.begin(), processes_.end()) + 1, 0);
+	std::vector<int> occurrenceVector(*std::max_element(processes_, processes_ + numberOfGenes_) + 1, 0);
 
 	int jobIndex;
 
@@ -119,24 +103,25 @@ void Coral::mutate(std::vector<Job> jobs,const int& numberOfMachines)
 		occurrenceVector[jobIndex]++;
 	}
 	int processIndex = occurrenceVector[jobIndex] - 1;
-	const int mutatedMachineIndex = mutatedMachineId-1;
-	int currentWorkpieceTime = jobs[jobIndex].processes[processIndex].machineDurations[mutatedMachineIndex];
-
-	while (currentWorkpieceTime == 100) {
-		mutatedMachineId = gen() % numberOfMachines + 1;
+	const int operation = instance.operationId(jobIndex, processIndex);
 
-		currentWorkpieceTime = jobs[jobIndex].processes[processIndex].machineDurations[mutatedMachineId-1];
+	if (!instance.isEligible(operation, mutatedMachineId-1)) {
+		mutatedMachineId = instance.eligibleMachine(operation, gen() % instance.eligibleCount(operation)) + 1;
 	}
 	
-	machines_[randomMachineIndex] = mutatedMachineId;
+	machines_[randomMachineIndex] = static_cast<MachineGene>(mutatedMachineId);
+	fitnessValid_ = false;
+	checkpoints_.invalidateFrom(randomMachineIndex);
+	return randomMachineIndex;
 }
 
-bool Coral::dominates(const std::shared_ptr<Coral>& coral)
+template <typename Genes>
+bool Coral<Genes>::dominates(const Coral<Genes>& coral) const
 {
-	if((maxCompletionTime_ <= coral->maxCompletionTime_ &&
-		totalEquipmentLoad_ <= coral->totalEquipmentLoad_) &&
-		(maxCompletionTime_ < coral->maxCompletionTime_ ||
-		totalEquipmentLoad_ < coral->totalEquipmentLoad_))
+	if((maxCompletionTime_ <= coral.maxCompletionTime_ &&
+		totalEquipmentLoad_ <= coral.totalEquipmentLoad_) &&
+		(maxCompletionTime_ < coral.maxCompletionTime_ ||
+		totalEquipmentLoad_ < coral.totalEquipmentLoad_))
 	{
 		return true;
 	}
@@ -144,20 +129,21 @@ bool Coral::dominates(const std::shared_ptr<Coral>& coral)
 	return false;
 }
 
-std::ostream& operator<<(std::ostream& os, const Coral& coral) 
+template <typename Genes>
+std::ostream& operator<<(std::ostream& os, const Coral<Genes>& coral) 
 {
     os << "Coral Info:" << std::endl;
     os << "Processes: ";
-    for (const int& process : coral.processes_) 
+    for (int gene = 0; gene < coral.numberOfGenes_; gene++) 
 	{
-        os << process << " ";
+        os << static_cast<int>(coral.processes_[gene]) << " ";
     }
     os << std::endl;
 
     os << "Machines: ";
-    for (const int& machine : coral.machines_) 
+    for (int gene = 0; gene < coral.numberOfGenes_; gene++) 
 	{
-        os << machine << " ";
+        os << static_cast<int>(coral.machines_[gene]) << " ";
     }
     os << std::endl;
 
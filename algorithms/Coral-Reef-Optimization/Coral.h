@@ -4,30 +4,47 @@
 #include <utility>
 
 
-#include "Job.h"
-
+#include "../Common/ProblemInstance.h"
+#include "../Common/ScheduleDecoder.h"
+#include "../Common/ChromosomePool.h"
+#include "../Common/GeneEncoding.h"
+#include "../Common/RandomEngine.h"
+
+// Objectives and decoder state of one coral. The genes are rows of the
+// CoralPool that owns the coral, stored in the integer types of the Genes
+// encoding.
+template <typename GeneEncodingT>
 class Coral
 {
 public:
-	Coral();
-	Coral(std::shared_ptr<Coral> coral);
-	Coral(std::vector<Job> jobs, int numProcesses, int numMachines, int seedEntropy);
-	std::string getGenesAsString();
-	void mutate(std::vector<Job> jobs, const int& numberOfMachines);
-	bool dominates(const std::shared_ptr<Coral>& coral);
-
-	std::vector<int> processes_; // <jobId>
-	std::vector<int> machines_;
+	using Genes = GeneEncodingT;
+	using JobGene = typename Genes::JobGene;
+	using MachineGene = typename Genes::MachineGene;
+
+	void initialize(const ProblemInstance& instance, RandomEngine& gen);
+	void copyFrom(const Coral& coral);
+	std::string getGenesAsString() const;
+	// Returns the position of the gene it changed
+	int mutate(const ProblemInstance& instance, RandomEngine& gen);
+	bool dominates(const Coral& coral) const;
+
+	JobGene* processes_ = nullptr; // <jobId>
+	MachineGene* machines_ = nullptr;
+	int numberOfGenes_ = 0;
 	int maxCompletionTime_ = 0;
 	int totalEquipmentLoad_ = 0;
+	// Objectives above match the genes until a genetic operator changes them
+	bool fitnessValid_ = false;
+	// Decoder state in front of the mutated gene of a brooded larva, so it is
+	// re-decoded from the mutation point. Empty on the reef.
+	DecoderCheckpoints checkpoints_;
 
 	int  dominationCount_ = 0;
-	std::vector<std::pair<int,int>> dominatedPoints_;
-
-	int frontLevel_ = 0;
-	float crowdingDistance_ = 0;
 
-	friend std::ostream& operator<<(std::ostream& os, const Coral& coral);
+	template <typename Encoding>
+	friend std::ostream& operator<<(std::ostream& os, const Coral<Encoding>& coral);
 };
 
-using CoralPtr = std::shared_ptr<Coral>;
+// Reef cells or larvae in water
+template <typename Genes>
+using CoralPool = ChromosomePool<Coral<Genes>>;
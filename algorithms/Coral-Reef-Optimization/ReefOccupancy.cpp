@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+
+#include "ReefOccupancy.h"
+
+void ReefOccupancy::reset(int cellCount)
+{
+	occupiedBits_.assign((cellCount + 63) / 64, 0);
+	occupiedCells_.clear();
+	freeCells_.resize(cellCount);
+	slots_.resize(cellCount);
+	for (int cell = 0; cell < cellCount; cell++)
+	{
+		freeCells_[cell] = cell;
+		slots_[cell] = cell;
+	}
+}
+
+void ReefOccupancy::occupy(int cell)
+{
+	if (isOccupied(cell))
+	{
+		return;
+	}
+	occupiedBits_[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+	moveCell(cell, freeCells_, occupiedCells_);
+}
+
+void ReefOccupancy::vacate(int cell)
+{
+	if (!isOccupied(cell))
+	{
+		return;
+	}
+	occupiedBits_[cell >> 6] &= ~(std::uint64_t(1) << (cell & 63));
+	moveCell(cell, occupiedCells_, freeCells_);
+}
+
+void ReefOccupancy::moveCell(int cell, std::vector<int>& from, std::vector<int>& to)
+{
+	// The last cell of the source list takes over the freed slot
+	const int slot = slots_[cell];
+	const int last = from.back();
+	from[slot] = last;
+	slots_[last] = slot;
+	from.pop_back();
+
+	slots_[cell] = static_cast<int>(to.size());
+	to.push_back(cell);
+}
+
+void ReefOccupancy::save(CheckpointWriter& out) const
+{
+	out.write(occupiedCount());
+	out.writeArray(occupiedCells_.data(), occupiedCells_.size());
+	out.writeArray(freeCells_.data(), freeCells_.size());
+}
+
+bool ReefOccupancy::restore(CheckpointReader& in, int cellCount)
+{
+	reset(cellCount);
+	int occupied = 0;
+	if (!in.readCount(occupied, cellCount))
+	{
+		return false;
+	}
+
+	// Occupied cells first, then the free ones
+	std::vector<int> cells(cellCount);
+	in.readArray(cells.data(), cells.size());
+	if (!in.good())
+	{
+		return false;
+	}
+
+	std::vector<bool> seen(cellCount, false);
+	for (int cell : cells)
+	{
+		if (cell < 0 || cell >= cellCount || seen[cell])
+		{
+			return false;
+		}
+		seen[cell] = true;
+	}
+
+	occupiedCells_.assign(cells.begin(), cells.begin() + occupied);
+	freeCells_.assign(cells.begin() + occupied, cells.end());
+	for (int slot = 0; slot < occupied; slot++)
+	{
+		occupiedBits_[occupiedCells_[slot] >> 6] |= std::uint64_t(1) << (occupiedCells_[slot] & 63);
+		slots_[occupiedCells_[slot]] = slot;
+	}
+	for (int slot = 0; slot < cellCount - occupied; slot++)
+	{
+		slots_[freeCells_[slot]] = slot;
+	}
+	return true;
+}
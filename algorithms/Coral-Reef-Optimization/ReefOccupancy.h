@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../Common/Checkpoint.h"
+
+// Occupied and free reef cells, each kept in a dense list with a cell -> list slot
+// index so cells move between the two lists in O(1)
+class ReefOccupancy
+{
+public:
+	void reset(int cellCount);
+
+	bool isOccupied(int cell) const { return (occupiedBits_[cell >> 6] >> (cell & 63)) & 1; }
+	void occupy(int cell);
+	void vacate(int cell);
+
+	int occupiedCount() const { return static_cast<int>(occupiedCells_.size()); }
+	int freeCount() const { return static_cast<int>(freeCells_.size()); }
+	int occupiedCell(int index) const { return occupiedCells_[index]; }
+	int freeCell(int index) const { return freeCells_[index]; }
+
+	// Both lists in order, cells are drawn from them by position
+	void save(CheckpointWriter& out) const;
+	// False if the lists read back do not hold every cell exactly once
+	bool restore(CheckpointReader& in, int cellCount);
+
+private:
+	void moveCell(int cell, std::vector<int>& from, std::vector<int>& to);
+
+	std::vector<std::uint64_t> occupiedBits_;
+	std::vector<int> occupiedCells_;
+	std::vector<int> freeCells_;
+	std::vector<int> slots_; // position of each cell in the list that holds it
+};
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+
+// Both solvers are compiled in, without their own entry points
+#define JSSP_NO_MAIN
+#include "../NSGA-II/NSGA2 Workshop.cpp"
+#include "../Coral-Reef-Optimization/CRO.cpp"
+#include "Hybrid.h"
+
+template <typename Genes>
+Hybrid<Genes>::Hybrid(int numberOfJobs, int numberOfMachines, int numberOfProcesses, int populationSize, int generations, std::vector<Job> jobs, const SolverOptions& options)
+	: generations_(generations), jobs_(std::move(jobs)), options_(options),
+	  instance_(jobs_, numberOfMachines), threadPool_(2),
+	  archive_(instance_.numberOfOperations(), options.archiveEpsilon), convergence_("Hybrid", std::cerr)
+{
+	// The engines split the threads; the reef is the smallest square with populationSize cells
+	SolverOptions engineOptions = options_;
+	engineOptions.numberOfThreads = std::max(1, options_.numberOfThreads / 2);
+	const int reefSize = std::max(2, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(populationSize)))));
+
+	nsga_ = std::make_unique<Nsga<Genes>>(numberOfJobs, numberOfMachines, generations, populationSize, numberOfProcesses, jobs_, engineOptions);
+	cro_ = std::make_unique<CRO<Genes>>(numberOfJobs, numberOfMachines, numberOfProcesses, reefSize, generations, jobs_, engineOptions);
+}
+
+template <typename Genes>
+void Hybrid<Genes>::run()
+{
+	// Rerunning with --seed <seed> repeats this run
+	std::cerr << "Hybrid seed: " << options_.seed << std::endl;
+
+	stopCondition_ = StopCondition(options_);
+
+	// Displaying the generated jobs and their processes
+	outputJobs(jobs_);
+
+	nsga_->prepareCoevolution(SolverStream);
+	cro_->prepareCoevolution(CoralReefStream);
+	nsga_->setStopCondition(stopCondition_);
+	cro_->setStopCondition(stopCondition_);
+
+	// The hypervolume reference point is fixed from the initial archives
+	nsgaAccepted_ += nsga_->offerToArchive(archive_);
+	croAccepted_ += cro_->offerToArchive(archive_);
+	archive_.fixReferencePoint();
+
+	// The engines only meet at the archive. It keeps the smaller genes of equal
+	// objectives and migrants are drawn after both engines offered theirs, so the
+	// result does not depend on which engine finishes a round first.
+	for (int first = 1; first <= generations_; first += options_.migrationInterval)
+	{
+		const int last = std::min(first + options_.migrationInterval - 1, generations_);
+
+		threadPool_.parallelFor(2, 1, [&](int begin, int end, int /*threadIndex*/)
+		{
+			for (int engine = begin; engine < end; engine++)
+			{
+				if (engine == 0)
+				{
+					nsga_->evolve(first, last);
+					nsgaAccepted_ += nsga_->offerToArchive(archive_);
+				}
+				else
+				{
+					cro_->evolve(first, last);
+					croAccepted_ += cro_->offerToArchive(archive_);
+				}
+			}
+		});
+
+		convergence_.record(last, archive_.hypervolume(), archive_.size());
+
+		// The engines share the deadline, so both stopped in this round
+		if (stopCondition_.recordGeneration(last, archive_.hypervolume()) || stopCondition_.shouldStop(last))
+		{
+			break;
+		}
+
+		if (last < generations_ && options_.migrants > 0)
+		{
+			nsga_->importFromArchive(archive_, options_.migrants);
+			cro_->importFromArchive(archive_, options_.migrants);
+		}
+	}
+
+	outputFront();
+
+	std::cerr << "Hybrid archive: " << archive_.size() << " members, " << nsgaAccepted_ << " insertions from NSGA-II, "
+			  << croAccepted_ << " from CRO" << std::endl;
+	stopCondition_.report(std::cerr, "Hybrid");
+	convergence_.printImprovements();
+}
+
+template <typename Genes>
+void Hybrid<Genes>::outputFront()
+{
+	// The front by increasing makespan. The frontend charts the second
+	// solution, so a front of one schedule is written twice.
+	PopulationArena<Genes> front(instance_.numberOfOperations());
+	archive_.copyMembers(front);
+	for (int i = 0; i < front.size(); i++)
+	{
+		std::cout << (i > 0 ? ";" : "") << front[i].getGenesAsString();
+	}
+	if (front.size() == 1)
+	{
+		std::cout << ";" << front[0].getGenesAsString();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 7)
+	{
+		std::cout << "Usage: " << argv[0] << " <numberOfJobs>" << " <numberOfMachines>" << " <numberOfProcesses>" << " <populationSize>" << " <generations>" << " <useDefault>"
+				  << " [--threads <count>] [--migration-interval <generations>] [--migrants <count>] [--reef-tiles <count>]"
+				  << " [--fitness-cache <slots>] [--archive-epsilon <fraction>] [--time-limit-ms <ms>]"
+				  << " [--stagnation-window <generations>] [--stagnation-epsilon <fraction>]"
+				  << " [--compact-genes 0|1] [--seed <seed>]. Only " << argc << " args provided." << std::endl;
+		return 0;
+	}
+
+	const int numberOfJobs = std::stoi(argv[1]);
+	const int numberOfMachines = std::stoi(argv[2]);
+	const int numberOfProcesses = std::stoi(argv[3]);
+	const int populationSize = std::stoi(argv[4]);
+	const int generations = std::stoi(argv[5]);
+	const std::string useDefault(argv[6]);
+	const SolverOptions options = SolverOptions::fromCommandLine(CommandLine(argc, argv, 7));
+
+	const std::string invalidOption = options.invalidOption();
+	if (!invalidOption.empty())
+	{
+		std::cerr << invalidOption << std::endl;
+		return 1;
+	}
+
+	// Engine checkpoints would not cover the shared archive between them
+	if (!options.checkpointPath.empty() || !options.resumePath.empty())
+	{
+		std::cerr << "Hybrid runs cannot be checkpointed or resumed" << std::endl;
+		return 1;
+	}
+
+	std::vector<Job> jobs = loadJobs(useDefault, numberOfJobs, numberOfMachines, numberOfProcesses, options.seed);
+	ProblemInstance instance(jobs, numberOfMachines);
+
+	// Every operation needs a machine to run on, or no schedule exists
+	const int unschedulable = instance.unschedulableOperation();
+	if (unschedulable != -1)
+	{
+		const int jobIndex = instance.jobOfOperation(unschedulable);
+		std::cerr << "Operation " << jobIndex + 1 << "," << unschedulable - instance.jobOffset(jobIndex) + 1
+				  << " cannot run on any machine." << std::endl;
+		return 1;
+	}
+
+	withGeneEncoding(instance, options.compactGenes, [&](auto genes)
+	{
+		using Genes = decltype(genes);
+		std::unique_ptr<Hybrid<Genes>> hybrid = std::make_unique<Hybrid<Genes>>(numberOfJobs, numberOfMachines, numberOfProcesses, populationSize, generations, jobs, options);
+		hybrid->run();
+	});
+	return 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include "../Common/ProblemInstance.h"
+#include "../Common/ThreadPool.h"
+#include "../Common/SolverOptions.h"
+#include "../Common/GeneEncoding.h"
+#include "../Common/RandomEngine.h"
+#include "../Common/ParetoArchive.h"
+#include "../Common/ConvergenceLog.h"
+#include "../Common/StopCondition.h"
+#include "../NSGA-II/NSGA2 Workshop.h"
+#include "../Coral-Reef-Optimization/CRO.h"
+
+// NSGA-II and CRO evolving the same instance side by side, one engine per
+// pool thread. Every migrationInterval generations both offer their best
+// chromosomes to a shared Pareto archive and then take migrants of it: NSGA-II
+// in place of its worst individuals, CRO as larvae. The merged front is the
+// result.
+template <typename Genes>
+class Hybrid {
+public:
+	Hybrid(int numberOfJobs, int numberOfMachines, int numberOfProcesses, int populationSize, int generations, std::vector<Job> jobs, const SolverOptions& options = SolverOptions());
+
+	void run();
+
+private:
+	void outputFront();
+
+	int generations_;
+	std::vector<Job> jobs_;
+	SolverOptions options_;
+	ProblemInstance instance_;
+	ThreadPool threadPool_; // runs the two engines
+	std::unique_ptr<Nsga<Genes>> nsga_;
+	std::unique_ptr<CRO<Genes>> cro_;
+	ParetoArchive<Genes> archive_;
+	ConvergenceLog convergence_; // hypervolume of the archive after every exchange
+	StopCondition stopCondition_;
+	int nsgaAccepted_ = 0; // archive insertions by each engine
+	int croAccepted_ = 0;
+};
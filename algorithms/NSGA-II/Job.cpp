@@ -1,4 +0,0 @@
-#include "Job.h"
-
-Job::Job() {}
-Job::Job(const std::vector<Process>& processes) : processes(processes) {}
\ No newline at end of file
@@ -10,40 +10,115 @@
 #include <fstream>
 #include <sstream>
 #include <iterator>
+#include <numeric>
+#include <cmath>
 
 #include "Nsga2 Workshop.h"
 #include "individual.cpp"
-
-Nsga::Nsga() 
+#include "../Common/ScheduleDecoder.cpp"
+#include "../Common/ThreadPool.cpp"
+#include "../Common/CrossoverEngine.cpp"
+#include "../Common/SolverOptions.h"
+#include "../Common/JobLoader.cpp"
+
+template <typename Genes>
+Nsga<Genes>::Nsga() 
 {
 	numberOfJobs_ = numberOfMachines_ = itterations_ = sampleSize_ = numberOfProcesses_ = 0;
 }
 
-Nsga::Nsga(int numberOfJobs, int numberOfMachines, int itterations,int sampleSize, int numberOfProcesses, std::string useDefault) {
+template <typename Genes>
+Nsga<Genes>::Nsga(int numberOfJobs, int numberOfMachines, int itterations,int sampleSize, int numberOfProcesses, std::vector<Job> jobs, const SolverOptions& options)
+	: options_(options), random_(options.seed, SolverStream), threadPool_(options.numberOfThreads)
+{
 	numberOfJobs_ = numberOfJobs;
 	numberOfMachines_ = numberOfMachines;
 	itterations_ = itterations;
 	sampleSize_ = sampleSize;
 	numberOfProcesses_ = numberOfProcesses;
-	useDefaultSample_ = useDefault;
+	jobs_ = std::move(jobs);
 }
 
-void Nsga::run() 
+template <typename Genes>
+bool Nsga<Genes>::run() 
 {
-	int itteration = 1;
+	// Rerunning with --seed <seed> repeats this run
+	std::cerr << "NSGA-II seed: " << options_.seed << std::endl;
 
-	// STEP 1: Population initialization
-	initalizePopulation();
+	stopCondition_ = StopCondition(options_);
+	prepareInstance();
+	convergence_ = std::make_unique<ConvergenceLog>("NSGA-II", std::cerr);
+
+	// Checkpoints hold a single population
+	if (options_.numberOfIslands > 1 && !(options_.checkpointPath.empty() && options_.resumePath.empty()))
+	{
+		std::cerr << "NSGA-II island runs cannot be checkpointed or resumed" << std::endl;
+		return false;
+	}
+
+	int resumedGeneration = 0;
+	if (!options_.resumePath.empty() && !restoreCheckpoint(resumedGeneration))
+	{
+		return false;
+	}
+	if (!options_.checkpointPath.empty())
+	{
+		catchTermination();
+	}
+
+	// Displaying the generated jobs and their processes
+	outputJobs(jobs_);
+
+	if (options_.numberOfIslands > 1)
+	{
+		runIslands();
+	}
+	else if (resumedGeneration > 0)
+	{
+		// The checkpointed run printed its first generation already
+		std::cout << firstGeneration_ << ";";
+		evolve(resumedGeneration + 1, itterations_);
+	}
+	else
+	{
+		// STEP 1: Population initialization
+		initalizePopulation();
+
+		evolve(1, itterations_);
+	}
 
-	while (itteration <= itterations_)
+	// STEP 7: Determination of the optimal solution
+	outputOptimalSolution();
+
+	stopCondition_.report(std::cerr, "NSGA-II");
+	convergence_->printImprovements();
+	if (fitnessCache_)
+	{
+		fitnessCache_->printStatistics(std::cerr, "NSGA-II");
+	}
+	return true;
+}
+
+template <typename Genes>
+void Nsga<Genes>::evolve(int firstIteration, int lastIteration)
+{
+	for (int itteration = firstIteration; itteration <= lastIteration; itteration++)
 	{
 		// STEP 2: Determination of the objective function fitness value
-		determineFitnessValue();
-		if(itteration == 1)
-			std::cout << population_[0]->getGenesAsString() << ";";
+		determineFitnessValue(population_);
+		if(itteration == 1 && reportsFirstGeneration_)
+		{
+			firstGeneration_ = population_[0].getGenesAsString();
+			std::cout << firstGeneration_ << ";";
+		}
+
+		if (stopCondition_.shouldStop(itteration))
+		{
+			break;
+		}
 
 		// STEP 3: Fast non-dominated and crowding ranking
-		nonDominatedSortingAndCrowdingDegree();
+		nonDominatedSortingAndCrowdingDegree(population_);
 
 		// STEP 4: Competition selection
 		competitionSelection();
@@ -59,240 +134,434 @@ void Nsga::run()
 
 		cleanupOldValues();
 
+		// Children not evaluated yet are dropped, the population stays the last complete one
+		if (stopCondition_.shouldStop(itteration))
+		{
+			offspring_.clear();
+			break;
+		}
+
 		// STEP 6: Elitist retention strategy
 		elitistRetention(itteration);
 
 		// Cleanup old values
 		cleanupOldValues();
 
-		// Genetic frequency plus one
-		itteration++;
-	}
+		if (convergence_)
+		{
+			convergence_->record(itteration, archive_->hypervolume(), archive_->size());
+			if (stopCondition_.recordGeneration(itteration, archive_->hypervolume()))
+			{
+				break;
+			}
+		}
 
-	// STEP 7: Determination of the optimal solution
-	outputOptimalSolution();
+		// Saved every checkpointInterval generations, and before stopping on SIGTERM
+		if (!options_.checkpointPath.empty())
+		{
+			const bool terminating = terminationRequested != 0;
+			if (terminating || (options_.checkpointInterval > 0 && itteration % options_.checkpointInterval == 0))
+			{
+				saveCheckpoint(itteration);
+			}
+			if (terminating)
+			{
+				stopCondition_.terminate(itteration);
+				break;
+			}
+		}
+	}
 }
 
-void Nsga::initalizePopulation()
+template <typename Genes>
+void Nsga<Genes>::runIslands()
 {
-	// Generate jobs
-	if (useDefaultSample_.size() == 1) {
-		if (std::stoi(useDefaultSample_) == 1) 
+	const int numberOfIslands = options_.numberOfIslands;
+	const int numberOfGenes = instance_.numberOfOperations();
+	const int migrants = std::min(options_.migrants, sampleSize_);
+
+	// Every island evolves a full population on one pool thread, with its own random stream.
+	// Islands share the fitness cache, which is safe for concurrent decoders.
+	SolverOptions islandOptions = options_;
+	islandOptions.numberOfThreads = 1;
+	islandOptions.numberOfIslands = 1;
+	islandOptions.fitnessCacheSize = 0;
+
+	islands_.clear();
+	mailboxes_.clear();
+	for (int i = 0; i < numberOfIslands; i++)
+	{
+		islands_.push_back(std::make_unique<Nsga<Genes>>(numberOfJobs_, numberOfMachines_, itterations_, sampleSize_, numberOfProcesses_, jobs_, islandOptions));
+		Nsga<Genes>& island = *islands_.back();
+		island.random_.seed(options_.seed, IslandStream + i);
+		island.reportsFirstGeneration_ = i == 0;
+		island.stopCondition_ = stopCondition_;
+		island.prepareInstance();
+		island.decoders_[0].setCache(fitnessCache_.get());
+		island.initalizePopulation();
+
+		mailboxes_.push_back(std::make_unique<MigrationMailbox<Individual<Genes>>>(numberOfGenes));
+	}
+
+	// The merged archive measures hypervolume against a point no island's initial population passes
+	std::pair<int, int> referencePoint(0, 0);
+	for (const auto& island : islands_)
+	{
+		referencePoint.first = std::max(referencePoint.first, island->archive_->referencePoint().first);
+		referencePoint.second = std::max(referencePoint.second, island->archive_->referencePoint().second);
+	}
+	archive_->setReferencePoint(referencePoint);
+
+	// Islands run migrationInterval generations between migrations. Round r posts to the
+	// neighbour's mailbox and takes the batch posted to its own one in round r - 1, so the
+	// result does not depend on how the islands are spread over threads.
+	std::vector<int> targets(numberOfIslands), ringOrder(numberOfIslands);
+	int round = 0;
+	for (int first = 1; first <= itterations_; first += options_.migrationInterval, round++)
+	{
+		const int last = std::min(first + options_.migrationInterval - 1, itterations_);
+
+		std::iota(ringOrder.begin(), ringOrder.end(), 0);
+		if (options_.migrationTopology == "random")
 		{
-			jobs_ = importDefaultSample();
-		} 
-		else 
+			std::shuffle(ringOrder.begin(), ringOrder.end(), random_);
+		}
+		for (int k = 0; k < numberOfIslands; k++)
 		{
-			jobs_ = generateJobs(numberOfJobs_, numberOfProcesses_, numberOfMachines_);
+			targets[ringOrder[k]] = ringOrder[(k + 1) % numberOfIslands];
+		}
+
+		threadPool_.parallelFor(numberOfIslands, 1, [&](int begin, int end, int /*threadIndex*/)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				Nsga<Genes>& island = *islands_[i];
+				island.receiveMigrants(*mailboxes_[i], round - 1);
+				island.evolve(first, last);
+				if (last < itterations_ && migrants > 0)
+				{
+					island.sendMigrants(*mailboxes_[targets[i]], round, migrants);
+				}
+			}
+		});
+
+		for (const auto& island : islands_)
+		{
+			island->archive_->offerMembers(*archive_);
+		}
+		convergence_->record(last, archive_->hypervolume(), archive_->size());
+
+		// Islands share the deadline, so they all stopped in this round
+		if (stopCondition_.recordGeneration(last, archive_->hypervolume()) || stopCondition_.shouldStop(last))
+		{
+			break;
 		}
-	} else {
-		jobs_ = importDefaultSample(useDefaultSample_);
 	}
 
-	// Displaying the generated jobs and their processes
-	outputJobs(jobs_);
+	// The reported solution is picked from the union of the islands
+	population_ = PopulationArena<Genes>(numberOfGenes);
+	offspring_ = PopulationArena<Genes>(numberOfGenes);
+	for (int i = 0; i < numberOfIslands; i++)
+	{
+		Nsga<Genes>& island = *islands_[i];
+		island.printIslandStatistics(i);
 
-	// Initialize population
-	for (int i=0; i<sampleSize_; i++)
+		const int offset = population_.size();
+		population_.resize(offset + island.population_.size());
+		for (int slot = 0; slot < island.population_.size(); slot++)
+		{
+			population_[offset + slot].copyFrom(island.population_[slot]);
+		}
+	}
+	islands_.clear();
+	mailboxes_.clear();
+}
+
+template <typename Genes>
+void Nsga<Genes>::sendMigrants(MigrationMailbox<Individual<Genes>>& mailbox, int round, int count)
+{
+	// Emigrants are the best ranked individuals: first front, most isolated first
+	determineFitnessValue(population_);
+	nonDominatedSortingAndCrowdingDegree(population_, count);
+
+	emigrants_.clear();
+	for (int k = 0; k < count && k < population_.size(); k++)
 	{
-		IndividualPtr individual = std::make_shared<Individual>(jobs_, numberOfProcesses_, numberOfMachines_, i*sampleSize_);
-		population_.push_back(individual);
+		emigrants_.push_back(&population_[ranking_[k]]);
 	}
+	mailbox.post(round, emigrants_.data(), static_cast<int>(emigrants_.size()));
+	cleanupOldValues();
 }
 
-void Nsga::determineFitnessValue() 
+template <typename Genes>
+void Nsga<Genes>::receiveMigrants(const MigrationMailbox<Individual<Genes>>& mailbox, int round)
 {
-	int individualNumber = 0;
-	
-	for(auto& individual : population_)
+	const PopulationArena<Genes>* immigrants = mailbox.collect(round);
+	if (immigrants == nullptr)
 	{
-		// calculate and set maximum completion time
-		int maxCompletionTime = 0;
-		// calculate and set total equipment load
-		int totalEquipmentLoad = 0;
+		return;
+	}
 
-		std::map<int, int> machinesRuntime; // <machineId, machineLoad>
-		std::map<int, int> jobRuntime;		// <jobId, jobCurrentTime>
-		std::vector<int> occurrenceVector(*max_element(individual->processes_.begin(), individual->processes_.end()) + 1, 0);
+	replaceWorst(*immigrants);
+	migrantsReceived_ += immigrants->size();
+}
 
-		for(int gene = 0; gene < numberOfProcesses_; gene++)
-		{
-			const int jobIndex = individual->processes_[gene] - 1;
-			occurrenceVector[jobIndex]++;
-			const int processIndex = occurrenceVector[jobIndex] - 1;
-			const int machineIndex = individual->machines_[gene] -1;
+template <typename Genes>
+void Nsga<Genes>::replaceWorst(const PopulationArena<Genes>& immigrants)
+{
+	// Immigrants replace the worst ranked individuals
+	determineFitnessValue(population_);
+	nonDominatedSortingAndCrowdingDegree(population_);
+	for (int k = 0; k < immigrants.size() && k < population_.size(); k++)
+	{
+		population_[ranking_[population_.size() - 1 - k]].copyFrom(immigrants[k]);
+	}
+	cleanupOldValues();
+}
 
-			// Get process duration for the machine
-			int currentWorkpieceTime = jobs_[jobIndex].processes[processIndex].machineDurations[machineIndex];
+template <typename Genes>
+void Nsga<Genes>::prepareCoevolution(std::uint64_t stream)
+{
+	random_.seed(options_.seed, stream);
+	reportsFirstGeneration_ = false;
+	prepareInstance();
+	initalizePopulation();
+	archiveImmigrants_ = PopulationArena<Genes>(instance_.numberOfOperations());
+}
 
-			auto jobTime = jobRuntime.find(jobIndex);
-			if (jobTime == jobRuntime.end())
-			{
-				jobRuntime[jobIndex] = 0;
-			}
+template <typename Genes>
+int Nsga<Genes>::offerToArchive(ParetoArchive<Genes>& archive)
+{
+	return archive_->offerMembers(archive);
+}
 
-			// seaching if the corresponding machine is already running
-			auto machineTime = machinesRuntime.find(machineIndex);
-			if (machineTime != machinesRuntime.end())
-			{
-				if (jobRuntime[jobIndex] > machinesRuntime[machineIndex])
-				{
-					jobRuntime[jobIndex] += currentWorkpieceTime;
-					machinesRuntime[machineIndex] = jobRuntime[jobIndex];
-				}
-				else
-				{
-					machinesRuntime[machineIndex] += currentWorkpieceTime;
-					jobRuntime[jobIndex] = machinesRuntime[machineIndex];
-				}
-			}
-			else
-			{
-				jobRuntime[jobIndex] += currentWorkpieceTime;
-				machinesRuntime.insert({machineIndex, jobRuntime[jobIndex]});
-			}
-		}
-		for(auto it : machinesRuntime)
+template <typename Genes>
+void Nsga<Genes>::importFromArchive(const ParetoArchive<Genes>& archive, int count)
+{
+	archiveImmigrants_.clear();
+	archive.sample(archiveImmigrants_, count, random_);
+	replaceWorst(archiveImmigrants_);
+	migrantsReceived_ += archiveImmigrants_.size();
+}
+
+template <typename Genes>
+void Nsga<Genes>::printIslandStatistics(int islandIndex)
+{
+	determineFitnessValue(population_);
+	nonDominatedSortingAndCrowdingDegree(population_, 1);
+
+	int bestMakespan = std::numeric_limits<int>::max();
+	int bestLoad = std::numeric_limits<int>::max();
+	for (int i = 0; i < population_.size(); i++)
+	{
+		bestMakespan = std::min(bestMakespan, population_[i].maxCompletionTime_);
+		bestLoad = std::min(bestLoad, population_[i].totalEquipmentLoad_);
+	}
+
+	std::cerr << "NSGA-II island " << islandIndex << ": first front " << frontOffsets_[1] - frontOffsets_[0]
+			  << ", best makespan " << bestMakespan << ", best load " << bestLoad
+			  << ", " << migrantsReceived_ << " migrants received" << std::endl;
+}
+
+template <typename Genes>
+void Nsga<Genes>::prepareInstance()
+{
+	instance_ = ProblemInstance(jobs_, numberOfMachines_);
+	decoders_.assign(threadPool_.size(), ScheduleDecoder(instance_));
+	crossovers_.assign(threadPool_.size(), CrossoverEngine(instance_));
+	archive_ = std::make_unique<ParetoArchive<Genes>>(instance_.numberOfOperations(), options_.archiveEpsilon);
+	if (options_.fitnessCacheSize > 0)
+	{
+		fitnessCache_ = std::make_unique<FitnessCache>(options_.fitnessCacheSize);
+		for (auto& decoder : decoders_)
 		{
-			if (it.second > maxCompletionTime)
-			{
-				maxCompletionTime = it.second;
-			}
-			totalEquipmentLoad+= it.second;
+			decoder.setCache(fitnessCache_.get());
 		}
-		population_[individualNumber]->maxCompletionTime_ = maxCompletionTime;
-		population_[individualNumber]->totalEquipmentLoad_ = totalEquipmentLoad;
-		individualNumber++;
 	}
 }
 
-void Nsga::nonDominatedSortingAndCrowdingDegree()
+template <typename Genes>
+void Nsga<Genes>::initalizePopulation()
+{
+	// Initialize population
+	population_ = PopulationArena<Genes>(instance_.numberOfOperations());
+	offspring_ = PopulationArena<Genes>(instance_.numberOfOperations());
+	population_.resize(sampleSize_);
+	for (int i=0; i<sampleSize_; i++)
+	{
+		population_[i].initialize(instance_, random_);
+	}
+
+	// The hypervolume reference point is fixed from the initial population
+	determineFitnessValue(population_);
+	archive_->fixReferencePoint();
+}
+
+template <typename Genes>
+void Nsga<Genes>::determineFitnessValue(PopulationArena<Genes>& population) 
 {
-	// Non-dominated values
-	std::vector<IndividualPtr> firstFront;
-	for (std::size_t i=0; i < population_.size(); i++)
+	// Only chromosomes changed by a genetic operator need decoding
+	evaluatedIndividuals_.clear();
+	evaluationBatch_.clear();
+	for(int i = 0; i < population.size(); i++)
 	{
-		for (int j=0; j < population_.size(); j++)
+		Individual<Genes>& individual = population[i];
+		if (individual.fitnessValid_)
 		{
-			// check if point 1 < point 2
-			if(population_[i]->dominates(population_[j]))
-			{
-				population_[i]->dominatedPoints_.push_back(j);
-			} else if (population_[j]->dominates(population_[i]))
-			{
-				population_[i]->dominationCount_+=1;
-			}
+			continue;
 		}
+		evaluatedIndividuals_.push_back(&individual);
+		evaluationBatch_.push_back({individual.processes_, individual.machines_});
+	}
+	evaluationResults_.resize(evaluationBatch_.size());
+
+	// Each thread decodes a contiguous, batch-aligned range with its own scratch buffers
+	threadPool_.parallelFor(static_cast<int>(evaluationBatch_.size()), ScheduleDecoder::batchWidth, [&](int begin, int end, int threadIndex)
+	{
+		decoders_[threadIndex].evaluateAll(evaluationBatch_.data() + begin, end - begin, evaluationResults_.data() + begin);
 
-		if (population_[i]->dominationCount_ == 0)
+		for(int i = begin; i < end; i++)
 		{
-			population_[i]->frontLevel_ = 0;
-			firstFront.push_back(population_[i]);
+			evaluatedIndividuals_[i]->maxCompletionTime_ = evaluationResults_[i].maxCompletionTime;
+			evaluatedIndividuals_[i]->totalEquipmentLoad_ = evaluationResults_[i].totalEquipmentLoad;
+			evaluatedIndividuals_[i]->fitnessValid_ = true;
 		}
+	});
+
+	for (const Individual<Genes>* individual : evaluatedIndividuals_)
+	{
+		archive_->offer(*individual);
 	}
+}
+
+template <typename Genes>
+void Nsga<Genes>::nonDominatedSortingAndCrowdingDegree(PopulationArena<Genes>& population, std::size_t rankLimit)
+{
+	const int size = population.size();
 
-	fronts_.push_back(firstFront);
+	// Sweep in (makespan, load) order, so only individuals already swept can dominate the current one
+	rankOrder_.resize(size);
+	std::iota(rankOrder_.begin(), rankOrder_.end(), 0);
+	std::sort(rankOrder_.begin(), rankOrder_.end(),
+		[&population](int a, int b) -> bool
+		{
+			if (population[a].maxCompletionTime_ == population[b].maxCompletionTime_)
+				return population[a].totalEquipmentLoad_ < population[b].totalEquipmentLoad_;
+			return population[a].maxCompletionTime_ < population[b].maxCompletionTime_;
+		});
 
-	int i = 0;
-	while(fronts_[i].size() > 0) 
+	// The last member swept into a front has its lowest load, so it is the only one that
+	// has to be checked. Front tails are ordered by (load, makespan), which makes the
+	// first front that does not dominate an individual a binary search away.
+	frontTails_.clear();
+	for (int index : rankOrder_)
 	{
-		std::vector<IndividualPtr> nextFront;
-		for(auto individual : fronts_[i]) {
-			for (auto j : individual->dominatedPoints_) 
+		const Individual<Genes>& individual = population[index];
+		auto front = std::lower_bound(frontTails_.begin(), frontTails_.end(), index,
+			[&population, &individual](int tail, int) -> bool
 			{
-				population_[j]->dominationCount_--;
-				if (population_[j]->dominationCount_ == 0) 
-				{
-					population_[j]->frontLevel_ = i+1;
-					nextFront.push_back(population_[j]);
-				}
-			}
+				const Individual<Genes>& last = population[tail];
+				if (last.totalEquipmentLoad_ == individual.totalEquipmentLoad_)
+					return last.maxCompletionTime_ < individual.maxCompletionTime_;
+				return last.totalEquipmentLoad_ < individual.totalEquipmentLoad_;
+			});
+
+		population[index].frontLevel_ = static_cast<int>(front - frontTails_.begin());
+		if (front == frontTails_.end())
+		{
+			frontTails_.push_back(index);
+		}
+		else
+		{
+			*front = index;
 		}
-		i++;
-		fronts_.push_back(nextFront);
 	}
 
-	for (std::vector<IndividualPtr> front : fronts_) 
+	// Each front becomes a span of ranking_
+	frontOffsets_.assign(frontTails_.size() + 1, 0);
+	for (int i = 0; i < size; i++)
 	{
-		if (front.size() > 0) 
+		frontOffsets_[population[i].frontLevel_ + 1]++;
+	}
+	std::partial_sum(frontOffsets_.begin(), frontOffsets_.end(), frontOffsets_.begin());
+
+	ranking_.resize(size);
+	std::copy(frontOffsets_.begin(), frontOffsets_.end() - 1, frontTails_.begin());
+	for (int i = 0; i < size; i++)
+	{
+		ranking_[frontTails_[population[i].frontLevel_]++] = i;
+	}
+
+	// Fronts past the rank limit keep a zero crowding distance
+	std::size_t ranked = 0;
+	for (std::size_t frontIndex = 0; frontIndex + 1 < frontOffsets_.size(); frontIndex++) 
+	{
+		if (ranked >= rankLimit)
 		{
-			int solutions_number = front.size();
-			// calculate crowding distance based on objective 1
-			std::sort(front.begin(), front.end(),
-				[](const IndividualPtr &a, const IndividualPtr &b) -> bool
-				{
-					return a->maxCompletionTime_ < b->maxCompletionTime_;
-				});
-			front[0]->crowdingDistance_ = front[solutions_number - 1]->crowdingDistance_ = std::numeric_limits<double>::infinity();
+			break;
+		}
 
-			std::vector<int> durationsInFront;
-			for (auto individual : front) 
-			{
-				durationsInFront.push_back(individual->maxCompletionTime_);
-			}
-			int scale = std::max_element(durationsInFront.begin(), durationsInFront.end()) - std::min_element(durationsInFront.begin(), durationsInFront.end()); 
-			if(scale == 0) scale = 1;
-			for (int i = 1; i < solutions_number - 1; i++) 
-			{
-				front[i]->crowdingDistance_ += static_cast<double>(front[i+1]->maxCompletionTime_ - front[i-1]->maxCompletionTime_) / static_cast<double>(scale);
-			}
+		auto first = ranking_.begin() + frontOffsets_[frontIndex];
+		auto last = ranking_.begin() + frontOffsets_[frontIndex + 1];
+		auto front = [&population, first](int i) -> Individual<Genes>& { return population[first[i]]; };
 
-			// calculate crowding distance based on objective 2
-			std::sort(front.begin(), front.end(),
-				[](const IndividualPtr &a, const IndividualPtr &b) -> bool
-				{
-					return a->totalEquipmentLoad_ < b->totalEquipmentLoad_;
-				});
-			front[0]->crowdingDistance_ = front[solutions_number - 1]->crowdingDistance_ = std::numeric_limits<double>::infinity();
+		int solutions_number = last - first;
+		ranked += solutions_number;
 
-			std::vector<int> totalLoadInFront;
-			for (auto individual : front) 
+		// calculate crowding distance based on objective 1
+		std::sort(first, last,
+			[&population](int a, int b) -> bool
 			{
-				totalLoadInFront.push_back(individual->totalEquipmentLoad_);
-			}
-			scale = std::max_element(totalLoadInFront.begin(), totalLoadInFront.end()) - std::min_element(totalLoadInFront.begin(), totalLoadInFront.end()); 
-			if(scale == 0) scale = 1;
-			for (int i = 1; i < solutions_number - 1; i++) 
-			{
-				front[i]->crowdingDistance_ += static_cast<double>(front[i+1]->totalEquipmentLoad_ - front[i-1]->totalEquipmentLoad_) / static_cast<double>(scale);
-			}
+				return population[a].maxCompletionTime_ < population[b].maxCompletionTime_;
+			});
+		front(0).crowdingDistance_ = front(solutions_number - 1).crowdingDistance_ = std::numeric_limits<double>::infinity();
+
+		int scale = front(solutions_number - 1).maxCompletionTime_ - front(0).maxCompletionTime_;
+		if(scale == 0) scale = 1;
+		for (int i = 1; i < solutions_number - 1; i++) 
+		{
+			front(i).crowdingDistance_ += static_cast<double>(front(i+1).maxCompletionTime_ - front(i-1).maxCompletionTime_) / static_cast<double>(scale);
 		}
-	}
 
-	std::sort(population_.begin(), population_.end(),
-		[](const IndividualPtr &a, const IndividualPtr &b) -> bool
+		// calculate crowding distance based on objective 2
+		std::sort(first, last,
+			[&population](int a, int b) -> bool
+			{
+				return population[a].totalEquipmentLoad_ < population[b].totalEquipmentLoad_;
+			});
+		front(0).crowdingDistance_ = front(solutions_number - 1).crowdingDistance_ = std::numeric_limits<double>::infinity();
+
+		scale = front(solutions_number - 1).totalEquipmentLoad_ - front(0).totalEquipmentLoad_;
+		if(scale == 0) scale = 1;
+		for (int i = 1; i < solutions_number - 1; i++) 
 		{
-			if (a->frontLevel_ == b->frontLevel_)
-				return a->crowdingDistance_ > b->crowdingDistance_;
-			else
-				return a->frontLevel_ < b->frontLevel_;
-		});
+			front(i).crowdingDistance_ += static_cast<double>(front(i+1).totalEquipmentLoad_ - front(i-1).totalEquipmentLoad_) / static_cast<double>(scale);
+		}
 
-	fronts_.clear();
+		// Fronts are already in rank order; within a front the larger crowding distance goes first
+		std::sort(first, last,
+			[&population](int a, int b) -> bool
+			{
+				return population[a].crowdingDistance_ > population[b].crowdingDistance_;
+			});
+	}
 }
 
-void Nsga::competitionSelection() 
+template <typename Genes>
+void Nsga<Genes>::competitionSelection() 
 {
-	std::random_device rd;
-	// Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	std::mt19937 gen(rd());
-
 	std::vector<int> selectedParents;
 
 	int retry = 0;
 
-	while (selectedParents.size() < population_.size()) 
+	while (selectedParents.size() < ranking_.size()) 
 	{
-		// Combine multiple sources of entropy for the seed
-    	std::size_t seed = rd() ^ now.time_since_epoch().count() ^ selectedParents.size();
-		gen.seed(seed);
+		int firstIndividual = random_() % ranking_.size();
+		int secondIndividual = random_() % ranking_.size();
+		const Individual<Genes>& first = population_[ranking_[firstIndividual]];
+		const Individual<Genes>& second = population_[ranking_[secondIndividual]];
 
-		int firstIndividual = gen() % population_.size();
-		int secondIndividual = gen() % population_.size();
-
-		if (retry < 50 && *population_[firstIndividual] == *population_[secondIndividual]) 
+		if (retry < 50 && first == second) 
 		{
 			retry++;
 			continue;
@@ -300,9 +569,9 @@ void Nsga::competitionSelection()
 
 		retry = 0;
 
-		if (population_[firstIndividual]->frontLevel_ == population_[secondIndividual]->frontLevel_) 
+		if (first.frontLevel_ == second.frontLevel_) 
 		{
-			if (population_[firstIndividual]->crowdingDistance_ > population_[secondIndividual]->crowdingDistance_) 
+			if (first.crowdingDistance_ > second.crowdingDistance_) 
 			{
 				selectedParents.push_back(firstIndividual);
 			} 
@@ -313,7 +582,7 @@ void Nsga::competitionSelection()
 			continue;
 		}
 
-		if (population_[firstIndividual]->frontLevel_ < population_[secondIndividual]->frontLevel_) 
+		if (first.frontLevel_ < second.frontLevel_) 
 		{
 			selectedParents.push_back(firstIndividual);
 		} else selectedParents.push_back(secondIndividual);
@@ -322,462 +591,266 @@ void Nsga::competitionSelection()
 	selectedParents_ = unique_pairs(selectedParents);
 }
 
-void Nsga::crossoverAndMutation() 
+template <typename Genes>
+void Nsga<Genes>::crossoverAndMutation() 
 {
-	std::srand(unsigned(std::time(0)));
 	std::vector<int> machineMask;
+	const int numberOfGenes = instance_.numberOfOperations();
 
-	std::random_device rd;
-	// Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count() ^ static_cast<std::size_t>(itterations_);
-	std::mt19937 gen(seed);
-	std::uniform_real_distribution<> dis(0, 1);
-
-	for (int i = 0; i < numberOfProcesses_ / 2; i++)
+	for (int i = 0; i < numberOfGenes / 2; i++)
 	{
 		machineMask.push_back(1);
 	}
 
-	for (int j = numberOfProcesses_ / 2; j < numberOfProcesses_; j++)
+	for (int j = numberOfGenes / 2; j < numberOfGenes; j++)
 	{
 		machineMask.push_back(0);
 	}
-	std::shuffle(machineMask.begin(), machineMask.end(), gen);
+	std::shuffle(machineMask.begin(), machineMask.end(), random_);
 
-	for(const auto& parents : selectedParents_) 
-	{
-		IndividualPtr child1 = std::make_shared<Individual>(population_[parents.first]);
-		IndividualPtr child2 = std::make_shared<Individual>(population_[parents.second]);
+	// Every parent pair draws from its own stream of the generation seed, so pairs can be
+	// bred concurrently and the children do not depend on the number of threads
+	const std::uint64_t generationSeed = random_();
 
-		double randomValue = dis(gen);
-		if (randomValue <= currentCrossoverProbability_) {
+	offspring_.resize(static_cast<int>(selectedParents_.size()) * 2);
 
-			double r = ((double)rand() / (RAND_MAX));
-			if (r >= 0.5) { // machine-base crossover
+	threadPool_.parallelFor(static_cast<int>(selectedParents_.size()), 1, [&](int begin, int end, int threadIndex)
+	{
+		for (int pairIndex = begin; pairIndex < end; pairIndex++)
+		{
+			RandomEngine pairGen(generationSeed, pairIndex);
+			breedPair(pairIndex, machineMask, pairGen, crossovers_[threadIndex]);
+		}
+	});
+}
 
-				std::vector<int> occurrenceVector(*max_element(child1->processes_.begin(), child1->processes_.end()) + 1, 0);
+template <typename Genes>
+void Nsga<Genes>::breedPair(int pairIndex, const std::vector<int>& machineMask, RandomEngine& gen, CrossoverEngine& crossover)
+{
+	const auto& parents = selectedParents_[pairIndex];
+	std::uniform_real_distribution<> dis(0, 1);
 
-				for (int iter = 0; iter < machineMask.size(); iter++)
-				{
-					int processGene1 = population_[parents.first]->processes_[iter];
-					occurrenceVector[processGene1]++;
-					if (machineMask[iter] == 1) 
-					{
-						int count = 0; // Counter for the occurrences of job 
-						int jobIndex2 = -1;
-
-						for (int i = 0; i < population_[parents.second]->processes_.size(); ++i) 
-						{
-							if (population_[parents.second]->processes_[i] == processGene1) 
-							{
-								count++; // Increment the occurrence count
-								if (count == occurrenceVector[processGene1]) 
-								{
-									jobIndex2 = i; // Return the index when Oth occurrence is found
-								}
-							}
-						}
-						if (jobIndex2 != -1) 
-						{
-							std::swap(child1->machines_[iter], child2->machines_[jobIndex2]);
-						}
-						else std::cout << "ERROR: machineBasedCrossover FAILED" << std::endl;
-					}
-				}
-			} 
-			else 
-			{ // process-based crossover
-				std::vector<int> firstGroup, secondGroup;
-				splitJobs(firstGroup, secondGroup);
-
-				int i = 0, j = 0;
-				while (i < numberOfProcesses_) {
-					int processGene1 = population_[parents.first]->processes_[i];
-					int machineGene1 = population_[parents.first]->machines_[i];
-
-					if (std::count(firstGroup.begin(), firstGroup.end(), processGene1)) 
-					{		
-						child1->processes_[i] = processGene1;
-						child1->machines_[i] = machineGene1;
-						i++;
-					}
-					else 
-					{
-						bool found = false;
-						while (!found && j < numberOfProcesses_) 
-						{
-							int processGene2 = population_[parents.second]->processes_[j];
-							int machineGene2 = population_[parents.second]->machines_[j];
-							if (std::count(secondGroup.begin(), secondGroup.end(), processGene2)) 
-							{
-								child1->processes_[i] = processGene2;
-								child1->machines_[i] = machineGene2;
-								i++; j++;
-								found = true;
-							}
-							else 
-							{
-								j++;
-							}
-						}
-					}
-				}
+	const Individual<Genes>& parent1 = population_[ranking_[parents.first]];
+	const Individual<Genes>& parent2 = population_[ranking_[parents.second]];
+	Individual<Genes>& child1 = offspring_[2 * pairIndex];
+	Individual<Genes>& child2 = offspring_[2 * pairIndex + 1];
+	child1.copyFrom(parent1);
+	child2.copyFrom(parent2);
 
+	double randomValue = dis(gen);
+	if (randomValue <= currentCrossoverProbability_) {
 
-				i = 0; j = 0;
-				while (i < numberOfProcesses_) 
-				{
-					int processGene2 = population_[parents.second]->processes_[i];
-					int machineGene2 = population_[parents.second]->machines_[i];
-
-					if (std::count(secondGroup.begin(), secondGroup.end(), processGene2)) 
-					{
-						child2->processes_[i] = processGene2;
-						child2->machines_[i] = machineGene2;
-						i++;
-					}
-					else 
-					{
-						bool found = false;
-						while (!found && j < numberOfProcesses_) {
-							int processGene1 = population_[parents.first]->processes_[j];
-							int machineGene1 = population_[parents.first]->machines_[j];
-							if (std::count(firstGroup.begin(), firstGroup.end(), processGene1)) 
-							{
-								child2->processes_[i] = processGene1;
-								child2->machines_[i] = machineGene1;
-								i++; j++;
-								found = true;
-							}
-							else j++;
-						}
-					}
-				}
-			}
+		double r = dis(gen);
+		if (r >= 0.5) { // machine-base crossover
+			crossover.machineBasedCrossover(parent1.processes_, child1.machines_, parent2.processes_, child2.machines_, machineMask);
+		} 
+		else 
+		{ // process-based crossover
+			crossover.splitJobs(gen);
+			crossover.jobBasedCrossover(parent1.processes_, parent1.machines_, parent2.processes_, parent2.machines_, true, child1.processes_, child1.machines_);
+			crossover.jobBasedCrossover(parent2.processes_, parent2.machines_, parent1.processes_, parent1.machines_, false, child2.processes_, child2.machines_);
+		}
 
-			double randomMutationDraw = ((double)rand() / (RAND_MAX));
+		// The crossover changed the genes copied from the parents
+		child1.fitnessValid_ = false;
+		child2.fitnessValid_ = false;
 
-			if (randomMutationDraw <= currentMutationProbability_) {
-				child1->mutate(jobs_, numberOfMachines_);
-				child2->mutate(jobs_, numberOfMachines_);
-			}
-		}
-		child1->isChild = true;
-		child2->isChild = true;
+		double randomMutationDraw = dis(gen);
 
-		newPopulation_.push_back(child1);
-		newPopulation_.push_back(child2);
+		if (randomMutationDraw <= currentMutationProbability_) {
+			child1.mutate(instance_, gen);
+			child2.mutate(instance_, gen);
+		}
 	}
+	child1.isChild = true;
+	child2.isChild = true;
 }
 
-void Nsga::elitistRetention(int iteration) 
+template <typename Genes>
+void Nsga<Genes>::elitistRetention(int iteration) 
 {
-	for (const auto& parents : selectedParents_) 
+	// Parents join the children in the offspring arena
+	const int numberOfChildren = offspring_.size();
+	offspring_.resize(numberOfChildren + static_cast<int>(selectedParents_.size()) * 2);
+	for (std::size_t pairIndex = 0; pairIndex < selectedParents_.size(); pairIndex++) 
 	{
-		IndividualPtr parent1 = std::make_shared<Individual>(population_[parents.first]);
-		IndividualPtr parent2 = std::make_shared<Individual>(population_[parents.second]);
-
-		newPopulation_.push_back(parent1);
-		newPopulation_.push_back(parent2);
-	}
-
-	population_.clear();
-
-	for (const auto individual : newPopulation_) 
-	{
-		IndividualPtr newIndividual = std::make_shared<Individual>(individual);
-		population_.push_back(newIndividual);
+		const auto& parents = selectedParents_[pairIndex];
+		offspring_[numberOfChildren + 2 * pairIndex].copyFrom(population_[ranking_[parents.first]]);
+		offspring_[numberOfChildren + 2 * pairIndex + 1].copyFrom(population_[ranking_[parents.second]]);
 	}
 
 	selectedParents_.clear();
-	newPopulation_.clear();
-
-	determineFitnessValue();
-	nonDominatedSortingAndCrowdingDegree();
 
-	std::vector<IndividualPtr> newPopulation;
+	determineFitnessValue(offspring_);
 
-	int currentParents = 0;
-	for (auto& individual : population_) 
+	// Selection stops after sampleSize_ individuals and skips at most the parents over the
+	// quota, so fronts beyond that many ranks never need a crowding distance
+	const double parentQuota = currentElitistRetentionFactor_ * sampleSize_;
+	std::size_t parents = 0;
+	for (int i = 0; i < offspring_.size(); i++) 
 	{
-		if (newPopulation.size() == sampleSize_) break;
-		if (!individual->isChild && currentParents >= static_cast<double>(currentElitistRetentionFactor_ * sampleSize_)) continue;
-		if (!individual->isChild) currentParents++;
-		IndividualPtr newIndividual = std::make_shared<Individual>(individual);
-		newPopulation.push_back(newIndividual);
+		parents += offspring_[i].isChild ? 0 : 1;
 	}
+	const std::size_t keptParents = std::min(parents, static_cast<std::size_t>(std::ceil(parentQuota)));
+	nonDominatedSortingAndCrowdingDegree(offspring_, sampleSize_ + (parents - keptParents));
 
+	// The current population has been copied out, so its arena receives the next generation
 	population_.clear();
 
-	for(auto& individual : newPopulation) 
+	int currentParents = 0;
+	for (int slot : ranking_) 
 	{
-		IndividualPtr newIndividual = std::make_shared<Individual>(individual);
-		population_.push_back(newIndividual);
+		if (population_.size() == sampleSize_) break;
+		const Individual<Genes>& individual = offspring_[slot];
+		if (!individual.isChild && currentParents >= parentQuota) continue;
+		if (!individual.isChild) currentParents++;
+		population_.resize(population_.size() + 1);
+		population_[population_.size() - 1].copyFrom(individual);
 	}
 
-	determineFitnessValue();
-	nonDominatedSortingAndCrowdingDegree();
+	offspring_.clear();
 }
 
-void Nsga::cleanupOldValues()
+template <typename Genes>
+void Nsga<Genes>::cleanupOldValues()
 {
-	for (auto iter : population_)
+	// Objective values stay cached on the chromosome; only ranking state is reset
+	for (int i = 0; i < population_.size(); i++)
 	{
-		iter->maxCompletionTime_ = 0;
-		iter->totalEquipmentLoad_ = 0;
-		iter->dominationCount_ = 0;
-		for (auto iter2 : iter->dominatedPoints_)
-		{
-			iter->dominatedPoints_.pop_back();
-		}
-		iter->frontLevel_ = 0;
-		iter->crowdingDistance_ = 0.0;
+		population_[i].frontLevel_ = 0;
+		population_[i].crowdingDistance_ = 0.0;
 	}
 }
 
-void Nsga::outputOptimalSolution() 
+template <typename Genes>
+void Nsga<Genes>::outputOptimalSolution() 
 {
-	determineFitnessValue();
-	nonDominatedSortingAndCrowdingDegree();
-
-	// Optimal solutions sorted by total front level and crowding distance
-	std::sort(population_.begin(), population_.end(),
-		[](const IndividualPtr &a, const IndividualPtr &b) -> bool
-		{
-			if (a->frontLevel_ == b->frontLevel_)
-				return a->crowdingDistance_ > b->crowdingDistance_;
-			else
-				return a->frontLevel_ < b->frontLevel_;
-		});
+	// The reported solution is the archived one with the lowest makespan; it
+	// may have left the population generations ago
+	determineFitnessValue(population_);
 
-	std::cout << population_[0]->getGenesAsString();
-}
+	PopulationArena<Genes> front(instance_.numberOfOperations());
+	archive_->copyMembers(front);
+	std::cout << front[0].getGenesAsString();
 
-void Nsga::calculateLinearlyDecreasingProbability(int iteration) 
-{
-	double progress = static_cast<double>(iteration) / itterations_;
-	currentCrossoverProbability_ = maxCrossoverProbability + progress * (minCrossoverProbability - maxCrossoverProbability);
-	currentMutationProbability_ = maxMutationProbability + progress * (minMutationProbability - maxMutationProbability);
+	std::cerr << "NSGA-II archive: " << front.size() << " members, makespan " << front[0].maxCompletionTime_ << "-" << front[front.size() - 1].maxCompletionTime_
+			  << ", load " << front[front.size() - 1].totalEquipmentLoad_ << "-" << front[0].totalEquipmentLoad_ << std::endl;
 }
 
-void Nsga::calculateElitistRetentionFactor(int iteration) 
+template <typename Genes>
+CheckpointHeader Nsga<Genes>::checkpointHeader(int generation) const
 {
-    if (iteration <= itterations_ / 3) {
-        currentElitistRetentionFactor_ = 0.4;
-    } else if (iteration >= itterations_) {
-        currentElitistRetentionFactor_ = 0.1;
-    } else {
-        double slope = (0.1 - 0.4) / (itterations_ - itterations_ / 3);
-        double intercept = 0.4 - slope * (itterations_ / 3);
-        currentElitistRetentionFactor_ = slope * iteration + intercept;
-    }
+	CheckpointHeader header;
+	header.solver = "NSGA-II";
+	header.seed = options_.seed;
+	header.geneBytes = sizeof(typename Genes::JobGene) + sizeof(typename Genes::MachineGene);
+	header.numberOfGenes = instance_.numberOfOperations();
+	header.populationSize = sampleSize_;
+	header.generations = itterations_;
+	header.generation = generation;
+	return header;
 }
 
-// utility methods
-
-std::vector<Job> Nsga::importDefaultSample(std::string fileName)
+template <typename Genes>
+void Nsga<Genes>::saveCheckpoint(int generation)
 {
-	std::vector<Job> jobs = std::vector<Job>(numberOfJobs_);
-
-	std::ifstream file(fileName);
-	std::string content;
-
-	if (!file.is_open()) 
-	{
-        content = "1,1:12,5,18,10,16,23,18,12,21,13;1,2:15,12,5,16,7,18,21,17,16,9;1,3:17,4,12,11,9,14,11,10,25,10;2,1:19,14,5,17,16,13,10,15,14,6;2,2:18,14,24,11,16,19,20,9,22,7;2,3:13,16,10,15,18,16,17,5,15,16;2,4:8,7,12,6,5,10,22,8,8,17;3,1:16,13,18,6,14,7,20,12,19,5;3,2:11,10,9,16,11,8,5,12,10,5;4,1:21,17,21,16,20,5,18,8,19,17;4,2:5,24,12,20,17,18,20,22,21,14;4,3:6,7,5,5,7,6,16,9,17,10;5,1:23,14,12,5,15,11,13,14,5,16;5,2:15,5,22,12,16,8,13,18,8,13;5,3:12,10,11,14,15,25,16,13,15,15;6,1:5,15,6,17,20,16,14,10,5,19;6,2:14,13,12,5,15,7,11,14,17,13;7,1:18,21,15,12,9,24,7,5,20,7;7,2:17,14,15,17,19,20,15,12,16,15;7,3:8,10,9,8,7,12,14,7,8,9;7,4:15,20,18,23,5,16,10,16,6,21;7,5:12,25,16,8,15,9,18,17,20,5;7,6:10,8,7,7,7,8,9,17,6,8;8,1:17,20,8,23,19,19,11,15,16,5;8,2:5,18,15,20,16,22,19,17,13,14;8,3:24,7,26,24,25,24,9,18,10,20;8,4:5,22,16,18,13,7,19,8,20,21;9,1:5,7,7,11,8,11,10,23,8,18;9,2:24,25,7,22,12,18,5,20,17,21;9,3:15,9,13,13,14,10,12,11,16,10;10,1:20,21,18,11,19,18,17,8,22,19;10,2:15,14,8,15,10,16,13,15,16,12;10,3:11,15,8,12,10,13,23,8,9,9";
-    } 
-	else 
+	// What a generation leaves to the next: the population, the random stream,
+	// the adaptive rates, the archive and the stagnation state
+	CheckpointWriter out(options_.checkpointPath);
+	out.writeHeader(checkpointHeader(generation));
+	out.write(random_);
+	out.write(currentCrossoverProbability_);
+	out.write(currentMutationProbability_);
+	out.write(currentElitistRetentionFactor_);
+	out.writeString(firstGeneration_);
+	out.write(population_.size());
+	for (int i = 0; i < population_.size(); i++)
 	{
-		if (fileName.compare("dataset.txt") == 0) 
-		{
-			content = std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-		} 
-		else 
-		{
-			std::stringstream result;
-
-			int number_total_jobs, number_total_machines, number_max_operations;
-			std::string line;
-			std::getline(file, line);
-			std::istringstream headerStream(line);
-			headerStream >> number_total_jobs >> number_total_machines >> number_max_operations;
-
-			// Set Job Id to 1 to initiate dataset load
-			int currentJob = 1;
-
-			while (std::getline(file, line)) 
-			{
-				if (currentJob > number_total_jobs) 
-				{
-					break;
-				}
-
-
-				std::istringstream lineStream(line);
-				int number_operations;
-				lineStream >> number_operations;
-
-				for (int id_operation = 0; id_operation < number_operations; ++id_operation) 
-				{
-					result << currentJob << "," << id_operation+1 << ":";
-					int machinesNumber;
-					lineStream >> machinesNumber;
-					std::map<int,int> machinesMap;
-					for (int i = 1; i <= number_total_machines; i++) 
-					{
-						machinesMap.insert(std::make_pair(i,100));
-					}
-					for (int i = 0; i < machinesNumber; i++) 
-					{
-						int machine, time;
-						lineStream >> machine >> time;
-						machinesMap[machine] = time;
-					}
-
-					for (int i = 1; i <= number_total_machines; i++) 
-					{
-						if (i == number_total_machines) 
-						{
-							result << machinesMap[i] << ";";
-							break;
-						}
-						result << machinesMap[i] << ",";
-					}
-				}
-				currentJob++;
-			}
-
-			content = result.str();
-		}
+		out.writeChromosome(population_[i]);
+		out.write(population_[i].isChild);
 	}
+	archive_->save(out);
+	stopCondition_.save(out);
 
-	size_t firstPeriodPos = content.find('.');
-    std::string jobsStr = content.substr(0, firstPeriodPos);
-    std::istringstream ssJobs(jobsStr);
-    std::string tokenJobs;
-
-	int currentJobIndex = 0;
-    while (std::getline(ssJobs, tokenJobs, ';')) 
+	if (!out.commit())
 	{
-        size_t colonPos = tokenJobs.find(':');
-        std::string operation = tokenJobs.substr(0, colonPos);
-        std::string durations = tokenJobs.substr(colonPos + 1);
-
-        std::istringstream durationsStream(durations);
-        std::vector<std::string> durationsArray(std::istream_iterator<std::string>{durationsStream}, 
-                                                std::istream_iterator<std::string>());
-
-		size_t colonPos2 = operation.find(',');
-        std::string jobId = operation.substr(0, colonPos2);
-
-		std::stringstream ssDurations(durations);
-		std::string tokenDurations;
-
-		std::map<int, int> processDurations;
-		int machineIndex = 0;
-		while (std::getline(ssDurations, tokenDurations, ',')) 
-		{
-			processDurations[machineIndex] = std::stoi(tokenDurations);
-			machineIndex++;
-		}
-
-		if (std::stoi(jobId) != (currentJobIndex+1)) 
-		{
-			currentJobIndex++;
-			
-		}
-		jobs[currentJobIndex].processes.push_back(Job::Process(processDurations));
-    }
-
-	file.close();
-	return jobs;
+		std::cerr << "NSGA-II could not write checkpoint " << options_.checkpointPath << std::endl;
+	}
 }
 
-std::vector<Job> Nsga::generateJobs(int numberOfJobs, int numberOfProcesses, int numberOfMachines)
+template <typename Genes>
+bool Nsga<Genes>::restoreCheckpoint(int& generation)
 {
-	std::vector<Job> jobs;
-
-	std::random_device rd;
-	// Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count() ^
-                       static_cast<std::size_t>(numberOfJobs);
-	std::mt19937 gen(seed);
-	std::uniform_int_distribution<> dis(0, numberOfJobs - 1);
-
-	for (int i = 0; i < numberOfJobs; i++) 
+	CheckpointReader in(options_.resumePath);
+	CheckpointHeader header;
+	if (!in.readHeader(header))
 	{
-		std::vector<Job::Process> jobProcesses;
-
-		std::map<int, int> processDurations;
-
-		for (int machineIndex = 0; machineIndex < numberOfMachines; ++machineIndex) {
-			processDurations[machineIndex] = std::max(static_cast<int>(gen() % maxDuration_) + 1, 1); // Random duration for each machine
-		}
-		jobProcesses.push_back(Job::Process(processDurations));
-		jobs.push_back(Job(jobProcesses));
-
-		numberOfProcesses--;
+		std::cerr << "NSGA-II cannot read checkpoint " << options_.resumePath << std::endl;
+		return false;
 	}
-
-	while (numberOfProcesses > 0) 
+	const std::string mismatch = header.mismatch(checkpointHeader(header.generation));
+	if (!mismatch.empty())
 	{
-		int randomJob = dis(gen);
-
-		std::map<int, int> processDurations;
-
-		for (int machineIndex = 0; machineIndex < numberOfMachines; ++machineIndex) 
-		{
-			processDurations[machineIndex] = std::max(static_cast<int>(gen() % maxDuration_) + 1, 1); // Random duration for each machine
-		}
+		std::cerr << "NSGA-II cannot resume from " << options_.resumePath << ": " << mismatch << std::endl;
+		return false;
+	}
 
-		jobs[randomJob].processes.push_back(Job::Process(processDurations));
+	in.read(random_);
+	in.read(currentCrossoverProbability_);
+	in.read(currentMutationProbability_);
+	in.read(currentElitistRetentionFactor_);
+	in.readString(firstGeneration_);
+
+	population_ = PopulationArena<Genes>(instance_.numberOfOperations());
+	offspring_ = PopulationArena<Genes>(instance_.numberOfOperations());
+	int size = 0;
+	in.readCount(size, sampleSize_);
+	population_.resize(size);
+	for (int i = 0; i < size; i++)
+	{
+		in.readChromosome(population_[i]);
+		in.read(population_[i].isChild);
+	}
 
-		numberOfProcesses--;
+	const bool archiveRestored = archive_->restore(in);
+	stopCondition_.restore(in);
+	if (!archiveRestored || !in.good())
+	{
+		std::cerr << "NSGA-II checkpoint " << options_.resumePath << " is damaged" << std::endl;
+		return false;
 	}
 
-	return jobs;
+	generation = header.generation;
+	std::cerr << "NSGA-II resumed after generation " << generation << std::endl;
+	return true;
 }
 
-void Nsga::splitJobs(std::vector<int>& firstGroup, std::vector<int>& secondGroup) 
+template <typename Genes>
+void Nsga<Genes>::calculateLinearlyDecreasingProbability(int iteration) 
 {
-	// Original vector of integers -> testing
-	std::vector<int> originalVector(jobs_.size());
-	std::iota(originalVector.begin(), originalVector.end(), 1);
-
-	std::random_device rd;
-	// Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count();
-	std::mt19937 gen(seed);
-
-	// Ensure that each resulting vector has at least a third of the original size
-	int minVectorSize = originalVector.size() / 3;
-
-	// Generate random sizes for the two new vectors
-	std::uniform_int_distribution<> distribution(minVectorSize, originalVector.size() - minVectorSize);
-	int firstVectorSize = distribution(gen);
-	int secondVectorSize = originalVector.size() - firstVectorSize;
-
-	// Shuffle the original vector to make the splitting random
-	std::shuffle(originalVector.begin(), originalVector.end(), gen);
-
-	// Create the two new vectors and copy elements
-	std::vector<int> firstVector(originalVector.begin(), originalVector.begin() + firstVectorSize);
-	std::vector<int> secondVector(originalVector.begin() + firstVectorSize, originalVector.end());
+	double progress = static_cast<double>(iteration) / itterations_;
+	currentCrossoverProbability_ = maxCrossoverProbability + progress * (minCrossoverProbability - maxCrossoverProbability);
+	currentMutationProbability_ = maxMutationProbability + progress * (minMutationProbability - maxMutationProbability);
+}
 
-	firstGroup = firstVector;
-	secondGroup = secondVector;
+template <typename Genes>
+void Nsga<Genes>::calculateElitistRetentionFactor(int iteration) 
+{
+    if (iteration <= itterations_ / 3) {
+        currentElitistRetentionFactor_ = 0.4;
+    } else if (iteration >= itterations_) {
+        currentElitistRetentionFactor_ = 0.1;
+    } else {
+        double slope = (0.1 - 0.4) / (itterations_ - itterations_ / 3);
+        double intercept = 0.4 - slope * (itterations_ / 3);
+        currentElitistRetentionFactor_ = slope * iteration + intercept;
+    }
 }
 
-void Nsga::minimizeAdjacentDuplicates(std::vector<int>& nums) 
+// utility methods
+
+template <typename Genes>
+void Nsga<Genes>::minimizeAdjacentDuplicates(std::vector<int>& nums) 
 {
     std::unordered_map<int, int> freqMap;
 
@@ -824,7 +897,8 @@ void Nsga::minimizeAdjacentDuplicates(std::vector<int>& nums)
     }
 }
 
-std::vector<std::pair<int, int>> Nsga::unique_pairs(const std::vector<int>& vec) 
+template <typename Genes>
+std::vector<std::pair<int, int>> Nsga<Genes>::unique_pairs(const std::vector<int>& vec) 
 {
     // Create a map to store frequency of each number
     std::map<int, int> freq;
@@ -911,88 +985,23 @@ std::vector<std::pair<int, int>> Nsga::unique_pairs(const std::vector<int>& vec)
     return pairs;
 }
 
-void Nsga::printPopulation()
+template <typename Genes>
+void Nsga<Genes>::printPopulation()
 {
 	int itteration = 0;
 
 	std::cout << "\nCurrent population:\n\n";
-	for (auto& individual : population_)
+	for (int slot : ranking_)
 	{
-		std::cout << "Individual " << std::setw(2) << ++itteration << ": " << individual->getGenesAsString()
-				  << "  Front Level: " << std::setw(2) << individual->frontLevel_
-				  << "  Crowding Distance: " << std::setw(10) << individual->crowdingDistance_ 
-				  << "	Domination Count: " << std::setw(10) << individual->dominationCount_ << std::endl;
+		const Individual<Genes>& individual = population_[slot];
+		std::cout << "Individual " << std::setw(2) << ++itteration << ": " << individual.getGenesAsString()
+				  << "  Front Level: " << std::setw(2) << individual.frontLevel_
+				  << "  Crowding Distance: " << std::setw(10) << individual.crowdingDistance_ << std::endl;
 	}
 	std::cout << "\n";
 }
 
-void Nsga::printJobs(std::vector<Job> jobs)
-{
-	for (int i = 0; i < jobs.size(); ++i) 
-	{
-		std::cout << "Job " << i + 1 << ":\n";
-		for (int j = 0; j < jobs[i].processes.size(); ++j) 
-		{
-			std::cout << "  Process " << j + 1 << ":\n";
-			for (const auto& durationPair : jobs[i].processes[j].machineDurations) 
-			{
-				std::cout << "    Machine " << durationPair.first << ": " << durationPair.second << " minutes\n";
-			}
-		}
-		std::cout << std::endl;
-	}
-}
-
-void Nsga::outputJobs(std::vector<Job> jobs)
-{
-	for (int i = 0; i < jobs.size(); ++i) 
-	{
-		for (int j = 0; j < jobs[i].processes.size(); ++j) 
-		{
-			std::cout << i + 1 << "," << j + 1 << ":";
-			for (const auto& durationPair : jobs[i].processes[j].machineDurations) 
-			{
-				if (std::addressof(durationPair) == std::addressof(*(std::prev(jobs[i].processes[j].machineDurations.end())))) 
-				{
-					if (i + 1 != jobs.size()) 
-					{
-						std::cout << durationPair.second << ";";
-					}
-					else 
-					{
-						if (j + 1 == jobs[i].processes.size())
-							std::cout << durationPair.second << ".";
-						else 
-						{
-							std::cout << durationPair.second << ";";
-						}
-					}
-				}
-				else 
-				{
-					std::cout << durationPair.second << ",";
-				}
-			}
-		}
-	}
-}
-
-void Nsga::printDominationValues()
-{
-	int i = 0;
-	std::cout << "\ndominationValues:\n";
-	for(auto& iter : population_)
-	{
-		std::cout << "Individual " << std::setw(2) << i++
-				  <<": domination_count: " << std::setw(2) << iter->dominationCount_ << " dominated_list: ";
-		for (auto iter2 : iter->dominatedPoints_)
-		{
-			std::cout << iter2 << " ";
-		}
-		std::cout << std::endl;
-	}
-}
-
+#ifndef JSSP_NO_MAIN
 int main(int argc, char* argv[])
 {
 	bool command_line_args = true;
@@ -1001,6 +1010,7 @@ int main(int argc, char* argv[])
 	int sampleSize;
 	int itterations;
 	std::string useDefault;
+	SolverOptions options;
 
 	if (command_line_args) 
 	{
@@ -1021,11 +1031,17 @@ int main(int argc, char* argv[])
 			// Sample data
 
 			useDefault = std::string(argv[6]);
+
+			options = SolverOptions::fromCommandLine(CommandLine(argc, argv, 7));
 		}
 		else 
 		{
 			// Print an error message if there are not enough arguments
-			std::cout << "Usage: " << argv[0] << " <numberOfJobs>" << " <numberOfMachines>" << " <numberOfProcesses>" << " <sampleSize>" << " <itterations>" << " <useDefault>. Only " << argc << " args provided." << std::endl;
+			std::cout << "Usage: " << argv[0] << " <numberOfJobs>" << " <numberOfMachines>" << " <numberOfProcesses>" << " <sampleSize>" << " <itterations>" << " <useDefault>"
+					  << " [--threads <count>] [--fitness-cache <slots>] [--archive-epsilon <fraction>] [--time-limit-ms <ms>]"
+					  << " [--stagnation-window <generations>] [--stagnation-epsilon <fraction>]"
+					  << " [--checkpoint <file>] [--checkpoint-interval <generations>] [--resume <file>]"
+					  << " [--compact-genes 0|1] [--seed <seed>]. Only " << argc << " args provided." << std::endl;
 			return 0;
 		}
 	}
@@ -1047,7 +1063,33 @@ int main(int argc, char* argv[])
 		std::cin >> itterations;
 	}
 
-	std::unique_ptr<Nsga> workshop = std::make_unique<Nsga>(numberOfJobs, numberOfMachines, itterations, sampleSize, numberOfProcesses, useDefault);
-	workshop->run();
-	return 0;
+	const std::string invalidOption = options.invalidOption();
+	if (!invalidOption.empty())
+	{
+		std::cerr << invalidOption << std::endl;
+		return 1;
+	}
+
+	std::vector<Job> jobs = loadJobs(useDefault, numberOfJobs, numberOfMachines, numberOfProcesses, options.seed);
+	ProblemInstance instance(jobs, numberOfMachines);
+
+	// Every operation needs a machine to run on, or no schedule exists
+	const int unschedulable = instance.unschedulableOperation();
+	if (unschedulable != -1)
+	{
+		const int jobIndex = instance.jobOfOperation(unschedulable);
+		std::cerr << "Operation " << jobIndex + 1 << "," << unschedulable - instance.jobOffset(jobIndex) + 1
+				  << " cannot run on any machine." << std::endl;
+		return 1;
+	}
+
+	bool completed = true;
+	withGeneEncoding(instance, options.compactGenes, [&](auto genes)
+	{
+		using Genes = decltype(genes);
+		std::unique_ptr<Nsga<Genes>> workshop = std::make_unique<Nsga<Genes>>(numberOfJobs, numberOfMachines, itterations, sampleSize, numberOfProcesses, jobs, options);
+		completed = workshop->run();
+	});
+	return completed ? 0 : 1;
 }
+#endif
@@ -1,26 +1,65 @@
 #pragma once
 #include <vector>
 #include <map>
-#include "Job.h"
+#include <random>
+#include <limits>
+#include <memory>
+#include "../Common/ProblemInstance.h"
+#include "../Common/ScheduleDecoder.h"
+#include "../Common/ThreadPool.h"
+#include "../Common/CrossoverEngine.h"
+#include "../Common/FitnessCache.h"
+#include "../Common/SolverOptions.h"
+#include "../Common/GeneEncoding.h"
+#include "../Common/RandomEngine.h"
+#include "../Common/MigrationMailbox.h"
+#include "../Common/ParetoArchive.h"
+#include "../Common/ConvergenceLog.h"
+#include "../Common/StopCondition.h"
+#include "../Common/Checkpoint.h"
 #include "individual.h"
 
+// Genes is the GeneEncoding the chromosomes are stored in
+template <typename Genes>
 class Nsga {
 public:
 	Nsga();
-	Nsga(int numberOfJobs, int numberOfMachines, int itterations, int sampleSize, int numberOfProcesses, std::string useDefault);
+	Nsga(int numberOfJobs, int numberOfMachines, int itterations, int sampleSize, int numberOfProcesses, std::vector<Job> jobs, const SolverOptions& options = SolverOptions());
 
-	void run();
+	// False if the run could not be resumed from options.resumePath
+	bool run();
+
+	// Stepwise use by the hybrid solver, which reports the results itself
+	void prepareCoevolution(std::uint64_t stream);
+	void evolve(int firstIteration, int lastIteration);
+	int offerToArchive(ParetoArchive<Genes>& archive);
+	void importFromArchive(const ParetoArchive<Genes>& archive, int count);
+	void setStopCondition(const StopCondition& stopCondition) { stopCondition_ = stopCondition; }
 
 private:
+	void prepareInstance();
 	void initalizePopulation();
-	void determineFitnessValue();
-	void nonDominatedSortingAndCrowdingDegree();
+	void determineFitnessValue(PopulationArena<Genes>& population);
+	void nonDominatedSortingAndCrowdingDegree(PopulationArena<Genes>& population, std::size_t rankLimit = std::numeric_limits<std::size_t>::max());
 	void competitionSelection();
 	void crossoverAndMutation();
+	void breedPair(int pairIndex, const std::vector<int>& machineMask, RandomEngine& gen, CrossoverEngine& crossover);
 	void elitistRetention(int interation);
 	void cleanupOldValues();
 	void outputOptimalSolution();
 
+	// single-population checkpoints
+	CheckpointHeader checkpointHeader(int generation) const;
+	void saveCheckpoint(int generation);
+	bool restoreCheckpoint(int& generation);
+
+	// island model
+	void runIslands();
+	void sendMigrants(MigrationMailbox<Individual<Genes>>& mailbox, int round, int count);
+	void receiveMigrants(const MigrationMailbox<Individual<Genes>>& mailbox, int round);
+	void replaceWorst(const PopulationArena<Genes>& immigrants);
+	void printIslandStatistics(int islandIndex);
+
 	void calculateLinearlyDecreasingProbability(int iteration);
 	void calculateElitistRetentionFactor(int iteration);
 	void selectionTournament(std::vector<int> &tournamnetIndexVector,
@@ -28,21 +67,14 @@ private:
 							 int iter);
 
 	// utility methods
-	std::vector<Job> importDefaultSample(std::string fileName = "dataset.txt");
-	std::vector<Job> generateJobs(int numberOfJobs, int numberOfProcesses, int numberOfMachines);
-	void splitJobs(std::vector<int>& firstGroup, std::vector<int>& secondGroup);
 	void minimizeAdjacentDuplicates(std::vector<int>& nums);
 	std::vector<std::pair<int, int>> unique_pairs(const std::vector<int>& vec);
 	void printPopulation();
-	void printJobs(std::vector<Job> jobs);
-	void outputJobs(std::vector<Job> jobs);
-	void printDominationValues();
 
 	int numberOfJobs_, numberOfMachines_;
 	int itterations_;
 	int sampleSize_;
 	int numberOfProcesses_;
-	const int maxDuration_ = 10;
 	const float maxCrowdingDistance_ = 10000;
 	double currentCrossoverProbability_ = 0.8;
 	double currentMutationProbability_ = 0.1;
@@ -59,11 +91,33 @@ private:
 	double minElitistRetentionFactor = 0.1;
 
 	std::vector<Job> jobs_;
-	std::vector<IndividualPtr> population_;
-	std::vector<std::pair<int,int>> selectedParents_;
-	std::vector<IndividualPtr> newPopulation_;
+	ProblemInstance instance_;
+	SolverOptions options_;
+	RandomEngine random_; // draws made on the solver thread
+	ThreadPool threadPool_;
+	std::vector<ScheduleDecoder> decoders_; // one per pool thread
+	std::vector<CrossoverEngine> crossovers_; // one per pool thread
+	std::unique_ptr<FitnessCache> fitnessCache_;
+	std::unique_ptr<ParetoArchive<Genes>> archive_; // every evaluated chromosome is offered to it
+	std::unique_ptr<ConvergenceLog> convergence_; // only runs that report their own results log one
+	StopCondition stopCondition_; // polled between phases
+	std::vector<Individual<Genes>*> evaluatedIndividuals_;
+	std::vector<ChromosomeRef<Genes>> evaluationBatch_;
+	std::vector<Fitness> evaluationResults_;
+	PopulationArena<Genes> population_; // current generation
+	PopulationArena<Genes> offspring_;  // children followed by copies of their parents
+	std::vector<std::pair<int,int>> selectedParents_; // positions in ranking_
 
-	std::vector<std::vector<IndividualPtr>> fronts_;
+	std::vector<int> ranking_; // slots of the last ranked arena, by front and crowding distance
+	std::vector<int> frontOffsets_; // front i spans ranking_[frontOffsets_[i], frontOffsets_[i + 1])
+	std::vector<int> rankOrder_;
+	std::vector<int> frontTails_; // last individual swept into each front
 
-	std::string useDefaultSample_ = "0";
+	std::vector<std::unique_ptr<Nsga<Genes>>> islands_;
+	std::vector<std::unique_ptr<MigrationMailbox<Individual<Genes>>>> mailboxes_; // inbox of each island
+	std::vector<const Individual<Genes>*> emigrants_;
+	PopulationArena<Genes> archiveImmigrants_;
+	int migrantsReceived_ = 0;
+	bool reportsFirstGeneration_ = true; // prints a first-generation solution, as the output format expects
+	std::string firstGeneration_; // that solution, which a resumed run prints again
 };
@@ -1,63 +1,52 @@
 #include <random>
 #include <algorithm>
 #include <string>
-#include <ctime>
-#include <chrono>
 
 #include "individual.h"
-#include "Job.cpp"
+#include "../Common/ProblemInstance.cpp"
 
-Individual::Individual() {}
-
-Individual::Individual(std::shared_ptr<Individual> individual)
+template <typename Genes>
+void Individual<Genes>::copyFrom(const Individual<Genes>& other)
 {
-	processes_ = individual->processes_;
-	machines_ = individual->machines_;
-	isChild = individual->isChild;
+	// Ranking state is not carried over, the copy is ranked again in its new population
+	std::copy(other.processes_, other.processes_ + numberOfGenes_, processes_);
+	std::copy(other.machines_, other.machines_ + numberOfGenes_, machines_);
+	isChild = other.isChild;
 
-	maxCompletionTime_ = 0;
-	totalEquipmentLoad_ = 0;
+	maxCompletionTime_ = other.maxCompletionTime_;
+	totalEquipmentLoad_ = other.totalEquipmentLoad_;
+	fitnessValid_ = other.fitnessValid_;
+
+	frontLevel_ = 0;
+	crowdingDistance_ = 0;
 }
 
-Individual::Individual(std::vector<Job> jobs, int numProcesses, int numMachines, int seedEntropy) {
+template <typename Genes>
+void Individual<Genes>::initialize(const ProblemInstance& instance, RandomEngine& gen) {
+	const int numProcesses = instance.numberOfOperations();
+
 	// Iterate through the jobs and their processes
-	for (int jobIndex = 0; jobIndex < jobs.size(); jobIndex++) {
-		for (int processIndex = 0; processIndex < jobs[jobIndex].processes.size(); processIndex++) {
-			processes_.push_back(jobIndex + 1);
+	int gene = 0;
+	for (int jobIndex = 0; jobIndex < instance.numberOfJobs(); jobIndex++) {
+		for (int processIndex = 0; processIndex < instance.jobLength(jobIndex); processIndex++) {
+			processes_[gene++] = static_cast<JobGene>(jobIndex + 1);
 		}
 	}
 
-	// Shuffle the processes using a random engine
-    std::random_device rd;
-
-    // Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count() ^
-                       static_cast<std::size_t>(seedEntropy);
-
-    // Initialize the random engine with the combined seed
-    std::mt19937 gen(seed);
-
-	std::shuffle(processes_.begin(), processes_.end(), gen);
-	std::vector<int> occurrenceVector(*max_element(processes_.begin(), processes_.end()) + 1, 0);
+	// Shuffle the processes
+	std::shuffle(processes_, processes_ + numberOfGenes_, gen);
+	std::vector<int> occurrenceVector(*std::max_element(processes_, processes_ + numberOfGenes_) + 1, 0);
 
 	for (int i = 0; i < numProcesses; i++) {
 		const int jobIndex = processes_[i] - 1;
 		occurrenceVector[jobIndex]++;
 		const int processIndex = occurrenceVector[jobIndex] - 1;
 
-		auto random = std::rand() % numMachines ;
-		
-		int currentWorkpieceTime = jobs[jobIndex].processes[processIndex].machineDurations[random];
+		const int operation = instance.operationId(jobIndex, processIndex);
 
-		while(currentWorkpieceTime == 100) {
-			random = std::rand() % numMachines;
-			currentWorkpieceTime = jobs[jobIndex].processes[processIndex].machineDurations[random];
-		}
+		const int random = instance.eligibleMachine(operation, gen() % instance.eligibleCount(operation));
 		
-		machines_.push_back(random+1); // Random machine ID
+		machines_[i] = static_cast<MachineGene>(random+1); // Random eligible machine ID
 	}
 
 
@@ -65,22 +54,28 @@ Individual::Individual(std::vector<Job> jobs, int numProcesses, int numMachines,
 	maxCompletionTime_ = 0;
 	// initialize with 0 total equipment load
 	totalEquipmentLoad_ = 0;
+	fitnessValid_ = false;
+	isChild = false;
+	frontLevel_ = 0;
+	crowdingDistance_ = 0;
 }
 
-std::string Individual::getGenesAsString()
+template <typename Genes>
+std::string Individual<Genes>::getGenesAsString() const
 {
 	std::stringstream result;
-	std::vector<int> occurrenceVector(*max_element(processes_.begin(), processes_.end()) + 1, 0);
+	std::vector<int> occurrenceVector(*std::max_element(processes_, processes_ + numberOfGenes_) + 1, 0);
 
-	for (auto process : processes_)
+	for (int gene = 0; gene < numberOfGenes_; gene++)
 	{
+		const int process = processes_[gene];
 		occurrenceVector[process]++;
 		result << std::to_string(process) << "," << std::to_string(occurrenceVector[process]) << " ";
 	}
 	
-	for (auto machine : machines_)
+	for (int gene = 0; gene < numberOfGenes_; gene++)
 	{
-		result << std::to_string(machine) << " ";
+		result << std::to_string(machines_[gene]) << " ";
 	}
 
 	result << std::to_string(maxCompletionTime_) << " ";
@@ -92,20 +87,13 @@ std::string Individual::getGenesAsString()
 	return output;
 }
 
-void Individual::mutate(std::vector<Job> jobs, const int& numberOfMachines)
+template <typename Genes>
+void Individual<Genes>::mutate(const ProblemInstance& instance, RandomEngine& gen)
 {
-	std::random_device rd;
-	// Get a high-resolution time point as part of the seed
-    auto now = std::chrono::high_resolution_clock::now();
-
-	// Combine multiple sources of entropy for the seed
-    std::size_t seed = rd() ^ now.time_since_epoch().count() ^ static_cast<std::size_t>(numberOfMachines);
-	std::mt19937 gen(seed);
-
-	int randomMachineIndex = gen() % processes_.size(); // m[3] = 2
+	int randomMachineIndex = gen() % numberOfGenes_; // m[3] = 2
 	int mutatedMachineId = machines_[randomMachineIndex];
 
-	std::vector<int> occurrenceVector(*max_element(processes_.begin(), processes_.end()) + 1, 0);
+	std::vector<int> occurrenceVector(*std::max_element(processes_, processes_ + numberOfGenes_) + 1, 0);
 
 	int jobIndex;
 
@@ -115,23 +103,22 @@ void Individual::mutate(std::vector<Job> jobs, const int& numberOfMachines)
 		occurrenceVector[jobIndex]++;
 	}
 	int processIndex = occurrenceVector[jobIndex] - 1;
-	const int mutatedMachineIndex = mutatedMachineId-1;
-	int currentWorkpieceTime = jobs[jobIndex].processes[processIndex].machineDurations[mutatedMachineIndex];
-
-	while (currentWorkpieceTime == 100) {
-		mutatedMachineId = gen() % numberOfMachines + 1;
+	const int operation = instance.operationId(jobIndex, processIndex);
 
-		currentWorkpieceTime = jobs[jobIndex].processes[processIndex].machineDurations[mutatedMachineId-1];
+	if (!instance.isEligible(operation, mutatedMachineId-1)) {
+		mutatedMachineId = instance.eligibleMachine(operation, gen() % instance.eligibleCount(operation)) + 1;
 	}
-	machines_[randomMachineIndex] = mutatedMachineId;
+	machines_[randomMachineIndex] = static_cast<MachineGene>(mutatedMachineId);
+	fitnessValid_ = false;
 }
 
-bool Individual::dominates(const std::shared_ptr<Individual>& individual)
+template <typename Genes>
+bool Individual<Genes>::dominates(const Individual<Genes>& individual) const
 {
-	if((maxCompletionTime_ <= individual->maxCompletionTime_ &&
-		totalEquipmentLoad_ <= individual->totalEquipmentLoad_) &&
-		(maxCompletionTime_ < individual->maxCompletionTime_ ||
-		totalEquipmentLoad_ < individual->totalEquipmentLoad_))
+	if((maxCompletionTime_ <= individual.maxCompletionTime_ &&
+		totalEquipmentLoad_ <= individual.totalEquipmentLoad_) &&
+		(maxCompletionTime_ < individual.maxCompletionTime_ ||
+		totalEquipmentLoad_ < individual.totalEquipmentLoad_))
 	{
 		return true;
 	}
@@ -139,8 +126,9 @@ bool Individual::dominates(const std::shared_ptr<Individual>& individual)
 	return false;
 }
 
-bool Individual::operator==(const Individual& other) const {
-    for (size_t i = 0; i < processes_.size(); ++i) {
+template <typename Genes>
+bool Individual<Genes>::operator==(const Individual<Genes>& other) const {
+    for (int i = 0; i < numberOfGenes_; ++i) {
         if (processes_[i] != other.processes_[i] || machines_[i] != other.machines_[i]) {
             return false;
         }
@@ -3,25 +3,35 @@
 #include <memory>
 #include <utility>
 
-#include "Job.h"
-
+#include "../Common/ProblemInstance.h"
+#include "../Common/ChromosomePool.h"
+#include "../Common/GeneEncoding.h"
+#include "../Common/RandomEngine.h"
+
+// Objectives and ranking state of one chromosome. The genes are rows of the
+// PopulationArena that owns the individual, stored in the integer types of
+// the Genes encoding.
+template <typename GeneEncodingT>
 struct Individual
 {
 public:
-	Individual();
-	Individual(std::shared_ptr<Individual> indidual);
-	Individual(std::vector<Job> jobs, int numProcesses, int numMachines, int seedEntropy);
-	std::string getGenesAsString();
-	void mutate(std::vector<Job> jobs, const int& numberOfMachines);
-	bool dominates(const std::shared_ptr<Individual>& indidual);
-
-	std::vector<int> processes_; // <jobId>
-	std::vector<int> machines_;
+	using Genes = GeneEncodingT;
+	using JobGene = typename Genes::JobGene;
+	using MachineGene = typename Genes::MachineGene;
+
+	void initialize(const ProblemInstance& instance, RandomEngine& gen);
+	void copyFrom(const Individual& other);
+	std::string getGenesAsString() const;
+	void mutate(const ProblemInstance& instance, RandomEngine& gen);
+	bool dominates(const Individual& individual) const;
+
+	JobGene* processes_ = nullptr; // <jobId>
+	MachineGene* machines_ = nullptr;
+	int numberOfGenes_ = 0;
 	int maxCompletionTime_ = 0;
 	int totalEquipmentLoad_ = 0;
-
-	int  dominationCount_ = 0;
-	std::vector<int> dominatedPoints_;
+	// Objectives above match the genes until a genetic operator changes them
+	bool fitnessValid_ = false;
 
 	int frontLevel_ = 0;
 	float crowdingDistance_ = 0;
@@ -31,4 +41,6 @@ public:
 	bool operator==(const Individual& other) const;
 };
 
-using IndividualPtr = std::shared_ptr<Individual>;
+// One generation of individuals
+template <typename Genes>
+using PopulationArena = ChromosomePool<Individual<Genes>>;
@@ -1,5 +1,8 @@
 import { spawn } from 'child_process';
 
+// Solver executables: NSGA-II, CRO, or both co-evolving through a shared Pareto archive
+const algorithms = ['nsga', 'cro', 'hybrid'];
+
 export async function uploadDataset(req, res) {
     if (!req.file) {
         return res.status(400).send('No file uploaded.');
@@ -9,7 +12,11 @@ export async function uploadDataset(req, res) {
 }
 
 export async function runScheduling(req, res) {
-    const { algorithm, numberOfJobs, numberOfMachines, generations, populationSize, numberOfProcesses, defaultSample } = req.body;
+    const { algorithm, numberOfJobs, numberOfMachines, generations, populationSize, numberOfProcesses, defaultSample, timeLimitMs } = req.body;
+
+    if (!algorithms.includes(algorithm)) {
+        return res.status(400).send('Unknown algorithm.');
+    }
 
     // Path to C++ executable
     const cppExecutablePath = `${process.env.EXE_PATH}${algorithm}.exe`;
@@ -17,6 +24,15 @@ export async function runScheduling(req, res) {
     // Input data to pass to the C++ executable
     const argumentsArray = [numberOfJobs, numberOfMachines, numberOfProcesses, populationSize, generations, defaultSample];
 
+    // Optional latency budget; the solver stops at it and returns the best front found so far
+    if (timeLimitMs !== undefined) {
+        const budget = Number(timeLimitMs);
+        if (!Number.isInteger(budget) || budget <= 0) {
+            return res.status(400).send('timeLimitMs must be a positive integer.');
+        }
+        argumentsArray.push('--time-limit-ms', String(budget));
+    }
+
     let options = {
         cwd: `${process.env.EXE_PATH}`
     };
@@ -30,6 +46,11 @@ export async function runScheduling(req, res) {
         outputData += data;
     });
 
+    // Solver statistics are reported on stderr
+    childProcess.stderr.on('data', data => {
+        console.log(`${data}`);
+    });
+
     // Handle process completion
     childProcess.on('close', code => {
         if (code === 0) {
@@ -257,9 +257,9 @@ function App() {
   }
 
   useEffect(() => {
-    if (algorithm === 'nsga') {
-      setPopulationSize(200);
-    } else setPopulationSize(10);
+    if (algorithm === 'cro') {
+      setPopulationSize(10);
+    } else setPopulationSize(200);
   },[algorithm])
 
   useEffect(() => {
@@ -268,9 +268,9 @@ function App() {
       setNumberOfMachines(10);
       setNumberOfProcesses(33);
       setGenerations(50);
-      if (algorithm === 'nsga') {
-        setPopulationSize(200);
-      } else setPopulationSize(10);
+      if (algorithm === 'cro') {
+        setPopulationSize(10);
+      } else setPopulationSize(200);
     }
   },[defaultSample])
 
@@ -99,6 +99,15 @@ const Toolbar = ({
                     onChange={() => setAlgorithm('cro')}
                     />
                     <b>MO-CROA</b>
+                <br />
+                <input
+                    type="radio"
+                    name="algorithm"
+                    value="hybrid"
+                    checked={algorithm === 'hybrid'}
+                    onChange={() => setAlgorithm('hybrid')}
+                    />
+                    <b>Hybrid</b>
             </div>
             <div className='instance-configurator'>
                 <div className='instance-type-container'>
@@ -134,7 +143,7 @@ const Toolbar = ({
                     </div>
 
                     <div className='problem-input'>
-                        <label htmlFor="populationSize">{algorithm === 'nsga' ? 'Population Size' : 'Reef size'}</label><br/>
+                        <label htmlFor="populationSize">{algorithm === 'cro' ? 'Reef size' : 'Population Size'}</label><br/>
                         <input type="text" id="populationSize" name="populationSize" required value={populationSize} onChange={(e) => setPopulationSize(e.target.value)}/>
                     </div>
                 </form>